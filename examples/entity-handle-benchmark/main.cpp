@@ -0,0 +1,231 @@
+#include <remi/ECS/Registry.h>
+#include <remi/Core/AABB/AABBTree.h>
+
+#include <glm/glm.hpp>
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdlib>
+#include <new>
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * The number of heap bytes currently allocated, counted by the global operator new and delete below.
+ */
+static size_t liveBytes = 0;
+
+/**
+ * Every allocation is prefixed with its size, so delete knows how many bytes are freed.
+ */
+static constexpr size_t ALLOCATION_HEADER_SIZE = alignof(std::max_align_t);
+
+void *operator new(size_t size)
+{
+    auto block = static_cast<char *>(std::malloc(size + ALLOCATION_HEADER_SIZE));
+    if (block == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    *reinterpret_cast<size_t *>(block) = size;
+    liveBytes += size;
+
+    return block + ALLOCATION_HEADER_SIZE;
+}
+
+void operator delete(void *pointer) noexcept
+{
+    if (pointer == nullptr)
+    {
+        return;
+    }
+
+    auto block = static_cast<char *>(pointer) - ALLOCATION_HEADER_SIZE;
+    liveBytes -= *reinterpret_cast<size_t *>(block);
+
+    std::free(block);
+}
+
+void operator delete(void *pointer, size_t size) noexcept
+{
+    operator delete(pointer);
+}
+
+struct Position
+{
+    glm::vec2 value;
+};
+
+struct Velocity
+{
+    glm::vec2 value;
+};
+
+double elapsedMilliseconds(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void printMemory(const std::string &name, size_t bytes, size_t count)
+{
+    std::cout << "  " << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << bytes / (1024.0 * 1024.0) << " MiB" << std::setw(10) << static_cast<double>(bytes) / count << " B/entity" << std::endl;
+}
+
+void printTime(const std::string &name, double milliseconds, size_t count)
+{
+    std::cout << "  " << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << milliseconds << " ms " << std::setw(9) << milliseconds * 1000000.0 / count << " ns/entity" << std::endl;
+}
+
+int main()
+{
+    const size_t entityCount = 1000000;
+
+    std::cout << "Entity handles are " << sizeof(ECS::Entity) * 8 << " bit (ECS_ENTITY_BITS), " << entityCount << " entities." << std::endl;
+    std::cout << "Build the engine and this example with -DECS_ENTITY_BITS=64 to compare." << std::endl
+              << std::endl;
+
+    std::cout << "memory (live heap bytes)" << std::endl;
+
+    auto *registry = new ECS::Registry(entityCount + 1);
+
+    // every entity has a position, every other one a velocity
+    auto start = Clock::now();
+    size_t before = liveBytes;
+
+    for (size_t i = 0; i < entityCount; i++)
+    {
+        auto e = registry->create();
+        registry->add(e, Position{glm::vec2(i, i)});
+
+        if (i % 2 == 0)
+        {
+            registry->add(e, Velocity{glm::vec2(1.0f, 0.5f)});
+        }
+    }
+
+    double createTime = elapsedMilliseconds(start);
+    printMemory("registry", liveBytes - before, entityCount);
+
+    // a cached view, like the ones every system iterates
+    start = Clock::now();
+    before = liveBytes;
+
+    auto &moving = registry->view<Position, Velocity>();
+
+    double viewTime = elapsedMilliseconds(start);
+    printMemory("view<Position, Velocity>", liveBytes - before, entityCount);
+
+    // the entity vectors passed between render passes
+    before = liveBytes;
+
+    auto *renderables = new std::vector<ECS::Entity>(registry->getEntities());
+
+    printMemory("std::vector<Entity> (render passes)", liveBytes - before, entityCount);
+
+    // the entity keyed maps of the physics world and scene graph
+    start = Clock::now();
+    before = liveBytes;
+
+    auto *bodies = new std::unordered_map<ECS::Entity, void *>();
+    bodies->reserve(entityCount);
+
+    for (auto e : *renderables)
+    {
+        bodies->emplace(e, nullptr);
+    }
+
+    double mapTime = elapsedMilliseconds(start);
+    printMemory("std::unordered_map<Entity, void *>", liveBytes - before, entityCount);
+
+    // the culling pass's AABB tree, which also keeps a set of its ids, the tree points to the AABBs so they are kept in a vector
+    // it is only filled with a tenth of the entities, as inserting a million AABBs takes minutes
+    const size_t treeCount = entityCount / 10;
+
+    std::vector<Core::AABB> aabbs;
+    aabbs.reserve(treeCount);
+
+    for (size_t i = 0; i < treeCount; i++)
+    {
+        // spread on a grid, so the tree stays balanced
+        auto position = glm::vec2((i * 7919) % 1000, ((i * 7919) / 1000) % 1000) * 2.0f;
+        aabbs.emplace_back(position, position + glm::vec2(1.0f));
+    }
+
+    start = Clock::now();
+    before = liveBytes;
+
+    auto *tree = new Core::AABBTree<ECS::Entity>(0.0f);
+
+    for (size_t i = 0; i < treeCount; i++)
+    {
+        tree->insert((*renderables)[i], aabbs[i]);
+    }
+
+    double treeTime = elapsedMilliseconds(start);
+    printMemory("Core::AABBTree<Entity> (1/10 entities)", liveBytes - before, treeCount);
+
+    std::cout << std::endl
+              << "throughput" << std::endl;
+
+    printTime("create + add", createTime, entityCount);
+    printTime("build view<Position, Velocity>", viewTime, moving.size());
+    printTime("fill unordered_map", mapTime, entityCount);
+    printTime("fill AABB tree (1/10 entities)", treeTime, treeCount);
+
+    glm::vec2 sum(0.0f);
+
+    start = Clock::now();
+
+    for (int run = 0; run < 10; run++)
+    {
+        registry->each<Position, Velocity>([&](ECS::Entity e, Position &position, Velocity &velocity)
+                                           { position.value += velocity.value; });
+    }
+
+    printTime("each<Position, Velocity> (x10)", elapsedMilliseconds(start) / 10, moving.size());
+
+    start = Clock::now();
+
+    for (int run = 0; run < 10; run++)
+    {
+        for (auto e : moving)
+        {
+            sum += registry->get<Position>(e).value;
+        }
+    }
+
+    printTime("view + get<Position> (x10)", elapsedMilliseconds(start) / 10, moving.size());
+
+    start = Clock::now();
+    size_t found = 0;
+
+    for (auto e : *renderables)
+    {
+        found += bodies->count(e);
+    }
+
+    printTime("unordered_map lookup", elapsedMilliseconds(start), entityCount);
+
+    start = Clock::now();
+
+    registry->destroyAll();
+
+    printTime("destroyAll", elapsedMilliseconds(start), entityCount);
+
+    delete tree;
+    delete bodies;
+    delete renderables;
+    delete registry;
+
+    // keep the results alive
+    std::cout << "  (checksum " << sum.x + sum.y + found << ")" << std::endl;
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include <remi/Core/Subject.h>
+#include <remi/Core/EventBus.h>
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * The event dispatched in every case.
+ */
+struct InputEvent
+{
+    int code;
+};
+
+/**
+ * The name the subject dispatches the event under, the window used "poll".
+ */
+const std::string InputEventName = "poll";
+
+/**
+ * A listener that is both a subject observer and an event bus member listener.
+ */
+class Listener : public Core::Observer<const InputEvent &>
+{
+public:
+    long long sum = 0;
+
+    void updateObserver(std::string event, const InputEvent &data) override
+    {
+        sum += data.code;
+    }
+
+    void onInput(const InputEvent &event)
+    {
+        sum += event.code;
+    }
+};
+
+/**
+ * Runs the given function a number of times and returns the average time of a run in nanoseconds.
+ */
+template <typename Func>
+double timeRuns(int runs, Func func)
+{
+    // warm up
+    func();
+
+    auto start = Clock::now();
+
+    for (int i = 0; i < runs; i++)
+    {
+        func();
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+
+    return static_cast<double>(elapsed) / runs;
+}
+
+void printResult(const std::string &name, double nanoseconds)
+{
+    std::cout << "  " << std::left << std::setw(36) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << nanoseconds << " ns" << std::endl;
+}
+
+void benchmark(size_t listenerCount)
+{
+    const int runs = 50;
+    const int eventsPerRun = 10000;
+
+    std::vector<Listener> listeners(listenerCount);
+    long long sum = 0;
+
+    Core::Subject<const InputEvent &> subject;
+    Core::Subject<const InputEvent &> functionSubject;
+    Core::EventBus memberBus;
+    Core::EventBus functionBus;
+
+    for (auto &listener : listeners)
+    {
+        subject.attachObserver(InputEventName, &listener);
+        functionSubject.attachObserver(InputEventName, [&](const InputEvent &event)
+                                       { sum += event.code; });
+
+        memberBus.subscribe<InputEvent, &Listener::onInput>(&listener);
+        functionBus.subscribe<InputEvent>([&](const InputEvent &event)
+                                          { sum += event.code; });
+    }
+
+    std::cout << "listeners: " << listenerCount << std::endl;
+
+    double subjectObservers = timeRuns(runs, [&]()
+                                       {
+                                           for (int i = 0; i < eventsPerRun; i++)
+                                           {
+                                               subject.notifyObservers(InputEventName, InputEvent{i});
+                                           } });
+
+    printResult("Subject, observer objects", subjectObservers / eventsPerRun);
+
+    double subjectFunctions = timeRuns(runs, [&]()
+                                       {
+                                           for (int i = 0; i < eventsPerRun; i++)
+                                           {
+                                               functionSubject.notifyObservers(InputEventName, InputEvent{i});
+                                           } });
+
+    printResult("Subject, function observers", subjectFunctions / eventsPerRun);
+
+    double busMembers = timeRuns(runs, [&]()
+                                 {
+                                     for (int i = 0; i < eventsPerRun; i++)
+                                     {
+                                         memberBus.publish(InputEvent{i});
+                                     } });
+
+    printResult("EventBus publish, member listeners", busMembers / eventsPerRun);
+
+    double busFunctions = timeRuns(runs, [&]()
+                                   {
+                                       for (int i = 0; i < eventsPerRun; i++)
+                                       {
+                                           functionBus.publish(InputEvent{i});
+                                       } });
+
+    printResult("EventBus publish, function listeners", busFunctions / eventsPerRun);
+
+    double busQueued = timeRuns(runs, [&]()
+                                {
+                                    for (int i = 0; i < eventsPerRun; i++)
+                                    {
+                                        memberBus.enqueue(InputEvent{i});
+                                    }
+
+                                    memberBus.flush(); });
+
+    printResult("EventBus enqueue + flush, members", busQueued / eventsPerRun);
+
+    for (auto &listener : listeners)
+    {
+        sum += listener.sum;
+    }
+
+    // keep the results alive
+    std::cout << "  (checksum " << sum << ")" << std::endl
+              << std::endl;
+}
+
+int main()
+{
+    std::cout << "Subject vs EventBus dispatch, ns per event averaged over 50 runs of 10000 events." << std::endl
+              << std::endl;
+
+    benchmark(1);
+    benchmark(2);
+    benchmark(8);
+
+    return 0;
+}
\ No newline at end of file
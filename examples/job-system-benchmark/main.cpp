@@ -0,0 +1,150 @@
+#include <remi/Core/JobSystem.h>
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <atomic>
+#include <vector>
+#include <string>
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Runs the given function a number of times and returns the average time of a run in nanoseconds.
+ */
+template <typename Func>
+double timeRuns(int runs, Func func)
+{
+    // warm up
+    func();
+
+    auto start = Clock::now();
+
+    for (int i = 0; i < runs; i++)
+    {
+        func();
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+
+    return static_cast<double>(elapsed) / runs;
+}
+
+void printResult(const std::string &name, double nanosecondsPerTask)
+{
+    std::cout << "  " << std::left << std::setw(36) << name << std::right << std::setw(10) << std::fixed << std::setprecision(1) << nanosecondsPerTask << " ns/task" << std::endl;
+}
+
+void benchmark(unsigned int workerCount)
+{
+    const size_t tasks = 100000;
+    const int runs = 10;
+
+    Core::JobSystem jobSystem(workerCount);
+
+    std::cout << "workers: " << jobSystem.getWorkerCount() << std::endl;
+
+    std::atomic<size_t> sink = 0;
+
+    // submit and wait on many empty jobs from the main thread
+    double submitWait = timeRuns(runs, [&]()
+                                 {
+                                     Core::JobSystem::Counter counter;
+
+                                     for (size_t i = 0; i < tasks; i++)
+                                     {
+                                         jobSystem.submit([&sink]()
+                                                          { sink.fetch_add(1, std::memory_order_relaxed); },
+                                                          counter);
+                                     }
+
+                                     jobSystem.wait(counter); });
+
+    printResult("submit + wait", submitWait / tasks);
+
+    // jobs which spawn their own jobs, so most jobs are pushed to and stolen from worker queues
+    const size_t parents = 100;
+    const size_t children = tasks / parents;
+
+    double nested = timeRuns(runs, [&]()
+                             {
+                                 Core::JobSystem::Counter counter;
+
+                                 for (size_t i = 0; i < parents; i++)
+                                 {
+                                     jobSystem.submit([&]()
+                                                      {
+                                                          Core::JobSystem::Counter childCounter;
+
+                                                          for (size_t j = 0; j < children; j++)
+                                                          {
+                                                              jobSystem.submit([&sink]()
+                                                                               { sink.fetch_add(1, std::memory_order_relaxed); },
+                                                                               childCounter);
+                                                          }
+
+                                                          jobSystem.wait(childCounter); },
+                                                      counter);
+                                 }
+
+                                 jobSystem.wait(counter); });
+
+    printResult("nested submit + wait (stealing)", nested / tasks);
+
+    // a chain of continuations, every job depends on the previous one so there is no parallelism, only scheduling
+    const size_t chainLength = 10000;
+
+    double chain = timeRuns(runs, [&]()
+                            {
+                                std::vector<Core::JobSystem::Counter> counters(chainLength);
+
+                                jobSystem.submit([&sink]()
+                                                 { sink.fetch_add(1, std::memory_order_relaxed); },
+                                                 counters[0]);
+
+                                for (size_t i = 1; i < chainLength; i++)
+                                {
+                                    jobSystem.submitAfter(counters[i - 1], [&sink]()
+                                                          { sink.fetch_add(1, std::memory_order_relaxed); },
+                                                          counters[i]);
+                                }
+
+                                // every earlier counter finished before the last job was queued
+                                jobSystem.wait(counters.back()); });
+
+    printResult("submitAfter chain", chain / chainLength);
+
+    // parallel for with one index per chunk, the worst case for scheduling overhead
+    double parallelFor = timeRuns(runs, [&]()
+                                  { jobSystem.parallelFor(0, tasks, 1, [&sink](size_t begin, size_t end)
+                                                          { sink.fetch_add(end - begin, std::memory_order_relaxed); }); });
+
+    printResult("parallelFor (grain size 1)", parallelFor / tasks);
+
+    // parallel for with a typical grain size, the overhead is amortised over the chunk
+    double parallelForGrain = timeRuns(runs, [&]()
+                                       { jobSystem.parallelFor(0, tasks, 1024, [&sink](size_t begin, size_t end)
+                                                               { sink.fetch_add(end - begin, std::memory_order_relaxed); }); });
+
+    printResult("parallelFor (grain size 1024)", parallelForGrain / tasks);
+
+    std::cout << std::endl;
+}
+
+int main()
+{
+    std::cout << "Job system scheduling overhead, averaged over 10 runs." << std::endl
+              << std::endl;
+
+    // no workers, every job runs inline on the main thread
+    benchmark(0);
+
+    benchmark(1);
+
+    if (Core::JobSystem::getDefaultWorkerCount() > 1)
+    {
+        benchmark(Core::JobSystem::getDefaultWorkerCount());
+    }
+
+    return 0;
+}
\ No newline at end of file
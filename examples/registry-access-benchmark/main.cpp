@@ -0,0 +1,176 @@
+#include <remi/ECS/Registry.h>
+
+#include <glm/glm.hpp>
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <random>
+
+using Clock = std::chrono::steady_clock;
+
+struct Position
+{
+    glm::vec2 value;
+};
+
+struct Velocity
+{
+    glm::vec2 value;
+};
+
+/**
+ * Stands in for the material components, which renderers look up with a chain of has and get.
+ */
+struct Tint
+{
+    glm::vec4 value;
+};
+
+/**
+ * The number of passes over the entities each measurement is averaged over.
+ */
+constexpr int RUNS = 20;
+
+double elapsedMilliseconds(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void printTime(const std::string &name, double milliseconds, size_t count)
+{
+    std::cout << "  " << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << milliseconds << " ms " << std::setw(9) << milliseconds * 1000000.0 / count << " ns/access" << std::endl;
+}
+
+/**
+ * Times RUNS passes of the given function over the entities, and prints the average time per access.
+ *
+ * An untimed pass is made first, so every measurement starts with the same caches.
+ */
+template <typename Func>
+void measure(const std::string &name, const std::vector<ECS::Entity> &entities, Func func)
+{
+    for (auto e : entities)
+    {
+        func(e);
+    }
+
+    auto start = Clock::now();
+
+    for (int run = 0; run < RUNS; run++)
+    {
+        for (auto e : entities)
+        {
+            func(e);
+        }
+    }
+
+    printTime(name, elapsedMilliseconds(start) / RUNS, entities.size());
+}
+
+int main()
+{
+    const size_t entityCount = 1000000;
+
+    std::cout << "Registry access is " << (ECS_CHECKED_ACCESS ? "checked" : "unchecked") << " (ECS_CHECKED_ACCESS), " << entityCount << " entities." << std::endl;
+    std::cout << "Build the engine and this example with and without -DNDEBUG, or with -DECS_CHECKED_ACCESS=0/1, to compare." << std::endl
+              << std::endl;
+
+    auto *registry = new ECS::Registry(entityCount + 1);
+
+    // every entity has a position and velocity, every other one a tint
+    for (size_t i = 0; i < entityCount; i++)
+    {
+        auto e = registry->create();
+        registry->add(e, Position{glm::vec2(i, i)});
+        registry->add(e, Velocity{glm::vec2(1.0f, 0.5f)});
+
+        if (i % 2 == 0)
+        {
+            registry->add(e, Tint{glm::vec4(1.0f)});
+        }
+    }
+
+    // render passes visit entities in culling order, not pool order, so the entities are shuffled
+    std::vector<ECS::Entity> entities = registry->view<Position, Velocity>();
+    std::shuffle(entities.begin(), entities.end(), std::mt19937(42));
+
+    const auto &constRegistry = *registry;
+
+    glm::vec4 sum(0.0f);
+
+    std::cout << "per access (shuffled order)" << std::endl;
+
+    measure("get<Position> const", entities, [&](ECS::Entity e)
+            { sum.x += constRegistry.get<Position>(e).value.x; });
+
+    measure("getUnchecked<Position> const", entities, [&](ECS::Entity e)
+            { sum.x += constRegistry.getUnchecked<Position>(e).value.x; });
+
+    measure("get<Position>", entities, [&](ECS::Entity e)
+            { sum.x += registry->get<Position>(e).value.x; });
+
+    measure("getUnchecked<Position>", entities, [&](ECS::Entity e)
+            { sum.x += registry->getUnchecked<Position>(e).value.x; });
+
+    measure("has<Tint> + get<Tint> const", entities, [&](ECS::Entity e)
+            {
+                if (constRegistry.has<Tint>(e))
+                {
+                    sum.y += constRegistry.get<Tint>(e).value.y;
+                } });
+
+    measure("tryGet<Tint> const", entities, [&](ECS::Entity e)
+            {
+                if (auto tint = constRegistry.tryGet<Tint>(e))
+                {
+                    sum.y += tint->value.y;
+                } });
+
+    // the shape of getMaterial before and after, the last component in the chain is always present
+    measure("has + get chain (Tint, Velocity)", entities, [&](ECS::Entity e)
+            {
+                if (constRegistry.has<Tint>(e))
+                {
+                    sum.z += constRegistry.get<Tint>(e).value.z;
+                }
+                else if (constRegistry.has<Velocity>(e))
+                {
+                    sum.z += constRegistry.get<Velocity>(e).value.y;
+                } });
+
+    measure("tryGet chain (Tint, Velocity)", entities, [&](ECS::Entity e)
+            {
+                if (auto tint = constRegistry.tryGet<Tint>(e))
+                {
+                    sum.z += tint->value.z;
+                }
+                else if (auto velocity = constRegistry.tryGet<Velocity>(e))
+                {
+                    sum.z += velocity->value.y;
+                } });
+
+    std::cout << std::endl
+              << "per entity (pool order)" << std::endl;
+
+    auto start = Clock::now();
+
+    for (int run = 0; run < RUNS; run++)
+    {
+        registry->each<Position, Velocity>([&](ECS::Entity e, Position &position, Velocity &velocity)
+                                           { sum.w += position.value.x + velocity.value.x; });
+    }
+
+    printTime("each<Position, Velocity>", elapsedMilliseconds(start) / RUNS, entities.size());
+
+    delete registry;
+
+    // keep the results alive
+    std::cout << "  (checksum " << sum.x + sum.y + sum.z + sum.w << ")" << std::endl;
+
+    return 0;
+}
@@ -60,7 +60,7 @@ int main()
     for (size_t i = 0; i < count; i++)
     {
         auto box = registry.create();
-        auto &boxMesh = registry.add(box, Rendering::Mesh2D(size, size));
+        auto &boxMesh = registry.emplace<Rendering::Mesh2D>(box, size, size);
         registry.add(box, Rendering::Material());
         registry.add(box, Rendering::Renderable(true, false));
 
@@ -70,7 +70,7 @@ int main()
 
         // use box mesh to create collider
         auto boxShape = Physics::PolygonColliderShape2D(boxMesh);
-        auto &boxCollider = registry.add(box, Physics::Collider2D(&boxShape));
+        auto &boxCollider = registry.emplace<Physics::Collider2D>(box, &boxShape);
 
         // make box non slippery
         boxCollider.setFriction(0.5f);
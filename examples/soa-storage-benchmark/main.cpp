@@ -0,0 +1,170 @@
+#include <remi/ECS/Registry.h>
+
+#include <glm/glm.hpp>
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Stands in for Core::PropertyChanges.
+ */
+struct PropertyChanges
+{
+    unsigned int translation = 0;
+    unsigned int scale = 0;
+    unsigned int shear = 0;
+    unsigned int rotation = 0;
+};
+
+/**
+ * A component with the same fields as Core::Transform, stored as an array of structs.
+ */
+struct TransformAoS
+{
+    unsigned int zIndex = 0;
+
+    glm::vec2 translation = glm::vec2(0.0f);
+    glm::vec2 scale = glm::vec2(1.0f);
+    glm::vec2 shear = glm::vec2(0.0f);
+    float rotation = 0;
+
+    PropertyChanges propertyChanges;
+
+    bool isTransformDirty = true;
+    glm::mat4 transformationMatrix = glm::mat4(1.0f);
+};
+
+/**
+ * The same component, stored as a struct of arrays.
+ */
+struct TransformSoA
+{
+    unsigned int zIndex = 0;
+
+    glm::vec2 translation = glm::vec2(0.0f);
+    glm::vec2 scale = glm::vec2(1.0f);
+    glm::vec2 shear = glm::vec2(0.0f);
+    float rotation = 0;
+
+    PropertyChanges propertyChanges;
+
+    bool isTransformDirty = true;
+    glm::mat4 transformationMatrix = glm::mat4(1.0f);
+};
+
+template <>
+struct ECS::ComponentStorage<TransformSoA>
+{
+    using Fields = ECS::SoAFields<&TransformSoA::zIndex, &TransformSoA::translation, &TransformSoA::scale, &TransformSoA::shear,
+                                  &TransformSoA::rotation, &TransformSoA::propertyChanges, &TransformSoA::isTransformDirty,
+                                  &TransformSoA::transformationMatrix>;
+};
+
+/**
+ * Runs the given function a number of times and returns the average time of a run in nanoseconds.
+ */
+template <typename Func>
+double timeRuns(int runs, Func func)
+{
+    // warm up
+    func();
+
+    auto start = Clock::now();
+
+    for (int i = 0; i < runs; i++)
+    {
+        func();
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+
+    return static_cast<double>(elapsed) / runs;
+}
+
+void printResult(const std::string &name, double aos, double soa)
+{
+    std::cout << "  " << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << aos << " ns" << std::setw(10) << soa << " ns" << std::setw(9) << aos / soa << "x" << std::endl;
+}
+
+void benchmark(size_t entityCount)
+{
+    const int runs = 20;
+
+    ECS::Registry registry(entityCount + 1);
+
+    for (size_t i = 0; i < entityCount; i++)
+    {
+        auto e = registry.create();
+
+        TransformAoS aos;
+        aos.translation = glm::vec2(i, i);
+
+        TransformSoA soa;
+        soa.translation = glm::vec2(i, i);
+
+        registry.add(e, aos);
+        registry.add(e, soa);
+    }
+
+    std::cout << "entities: " << entityCount << " (" << sizeof(TransformAoS) << " byte component)" << std::endl;
+    std::cout << "  " << std::left << std::setw(24) << "pass" << std::right << std::setw(13) << "AoS" << std::setw(13) << "SoA" << std::setw(10) << "speedup" << std::endl;
+
+    glm::vec2 velocity(0.5f, -0.25f);
+
+    // translation only, reads and writes 8 bytes of each component
+    double aosTranslate = timeRuns(runs, [&]()
+                                   { registry.each<TransformAoS>([&](ECS::Entity e, TransformAoS &t)
+                                                                 { t.translation += velocity; }); });
+
+    double soaTranslate = timeRuns(runs, [&]()
+                                   { registry.each<TransformSoA>([&](ECS::Entity e, ECS::SoARef<TransformSoA> t)
+                                                                 { t.field<&TransformSoA::translation>() += velocity; }); });
+
+    printResult("translation only", aosTranslate / entityCount, soaTranslate / entityCount);
+
+    // matrix only, reads 64 bytes of each component
+    glm::vec4 sum(0.0f);
+
+    double aosMatrix = timeRuns(runs, [&]()
+                                { registry.each<TransformAoS>([&](ECS::Entity e, TransformAoS &t)
+                                                              { sum += t.transformationMatrix * glm::vec4(1.0f); }); });
+
+    double soaMatrix = timeRuns(runs, [&]()
+                                { registry.each<TransformSoA>([&](ECS::Entity e, ECS::SoARef<TransformSoA> t)
+                                                              { sum += t.field<&TransformSoA::transformationMatrix>() * glm::vec4(1.0f); }); });
+
+    printResult("matrix only", aosMatrix / entityCount, soaMatrix / entityCount);
+
+    // fields spread over the whole component, the case struct of arrays is worst at as every field is a separate stream
+    double aosSpread = timeRuns(runs, [&]()
+                                { registry.each<TransformAoS>([&](ECS::Entity e, TransformAoS &t)
+                                                              { sum.x += t.zIndex + t.translation.x + t.rotation + t.transformationMatrix[3][0]; }); });
+
+    double soaSpread = timeRuns(runs, [&]()
+                                { registry.each<TransformSoA>([&](ECS::Entity e, ECS::SoARef<TransformSoA> t)
+                                                              { sum.x += t.field<&TransformSoA::zIndex>() + t.field<&TransformSoA::translation>().x +
+                                                                         t.field<&TransformSoA::rotation>() + t.field<&TransformSoA::transformationMatrix>()[3][0]; }); });
+
+    printResult("four spread fields", aosSpread / entityCount, soaSpread / entityCount);
+
+    // keep the results alive
+    std::cout << "  (checksum " << sum.x + sum.y + sum.z + sum.w << ")" << std::endl
+              << std::endl;
+}
+
+int main()
+{
+    std::cout << "Array of structs vs struct of arrays component storage, ns per entity averaged over 20 runs." << std::endl
+              << std::endl;
+
+    benchmark(10000);
+    benchmark(100000);
+    benchmark(1000000);
+
+    return 0;
+}
\ No newline at end of file
@@ -91,7 +91,7 @@ int main()
         // use char mesh to create collider
         // note: char mesh is concave so we use compound polygon collider
         auto charShape = Physics::CompoundPolygonColliderShape2D(charMesh);
-        auto &charCollider = registry.add(charEntity, Physics::Collider2D(&charShape));
+        auto &charCollider = registry.emplace<Physics::Collider2D>(charEntity, &charShape);
 
         // make text non slippery
         charCollider.setFriction(0.5f);
@@ -0,0 +1,411 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace Core
+{
+    using EventId = std::size_t;
+
+    /**
+     * Interns an event name, returning a dense id for it.
+     *
+     * Ids are handed out in the order names are first seen, starting at 0, so they can index a flat array.
+     * This function is thread safe.
+     *
+     * @param name The name of the event.
+     *
+     * @returns The event's id.
+     */
+    EventId internEvent(const std::string &name);
+
+    /**
+     * Generates ids for event types.
+     */
+    class EventIdGenerator
+    {
+    public:
+        /**
+         * The interned id of the event type.
+         *
+         * The lookup only happens once per type, after that the id is a static variable.
+         *
+         * NOTE: The id is interned by the name of the type instead of incrementing a static variable.
+         *       This is because different dlls and exes will generate their own version of the template and
+         *       therefore have different ids for the same event.
+         */
+        template <typename E>
+        inline static const EventId id = internEvent(typeid(E).name());
+    };
+
+    /**
+     * Dispatches typed events to listeners.
+     *
+     * An event is any type, the type itself identifies the event, so publishing an event is an array index and a loop over its listeners.
+     * There is no string hashing or lookup when publishing.
+     *
+     * Events can be delivered immediately with `publish`, or queued with `enqueue` and delivered in a batch with `flush`, e.g. at a frame boundary.
+     *
+     * Listeners subscribed during the delivery of their event only receive events of that type published after the delivery finishes.
+     *
+     * @note Listeners must not unsubscribe listeners of the event being published or flushed.
+     */
+    class EventBus
+    {
+    public:
+        using ListenerId = std::size_t;
+
+        EventBus() = default;
+
+        EventBus(const EventBus &) = delete;
+        EventBus &operator=(const EventBus &) = delete;
+
+        /**
+         * Destroys the event bus, dropping all listeners and queued events.
+         */
+        ~EventBus()
+        {
+            for (auto channel : channels)
+            {
+                delete channel;
+            }
+        }
+
+        /**
+         * Subscribes a callable to an event.
+         *
+         * @tparam E The event type.
+         * @param listener The callable, it is invoked with `const E &`.
+         *
+         * @returns An id that can be used to unsubscribe the listener.
+         */
+        template <typename E, typename Callable>
+        requires(std::is_invocable_v<std::decay_t<Callable> &, const E &>)
+        ListenerId subscribe(Callable &&listener)
+        {
+            auto &channel = getChannel<E>();
+
+            channel.add(Listener<E>{
+                .id = nextListenerId,
+                .invoke = &invokeCallback<E>,
+                .instance = nullptr,
+                .callback = std::forward<Callable>(listener),
+            });
+
+            return nextListenerId++;
+        }
+
+        /**
+         * Subscribes a member function to an event.
+         *
+         * The member function is called directly, without going through a std::function.
+         *
+         * @tparam E The event type.
+         * @tparam Method The member function, it takes `const E &`.
+         * @param instance The object to call the member function on, it must outlive the subscription.
+         *
+         * @returns An id that can be used to unsubscribe the listener.
+         */
+        template <typename E, auto Method, typename Class>
+        requires(std::is_invocable_v<decltype(Method), Class *, const E &>)
+        ListenerId subscribe(Class *instance)
+        {
+            auto &channel = getChannel<E>();
+
+            channel.add(Listener<E>{
+                .id = nextListenerId,
+                .invoke = &invokeMethod<E, Class, Method>,
+                .instance = instance,
+                .callback = nullptr,
+            });
+
+            return nextListenerId++;
+        }
+
+        /**
+         * Unsubscribes a listener from an event.
+         *
+         * Does nothing if the listener is not subscribed to the event.
+         *
+         * @tparam E The event type.
+         * @param listenerId The id returned by subscribe.
+         */
+        template <typename E>
+        void unsubscribe(ListenerId listenerId)
+        {
+            auto channel = findChannel<E>();
+            if (channel == nullptr)
+            {
+                return;
+            }
+
+            channel->remove(listenerId);
+        }
+
+        /**
+         * Checks if an event has any listeners.
+         *
+         * @tparam E The event type.
+         *
+         * @returns Whether or not the event has listeners.
+         */
+        template <typename E>
+        bool hasListeners() const
+        {
+            auto channel = findChannel<E>();
+
+            return channel != nullptr && (!channel->listeners.empty() || !channel->subscribedDuringDelivery.empty());
+        }
+
+        /**
+         * Delivers an event to its listeners immediately, in the order they subscribed.
+         *
+         * @tparam E The event type.
+         * @param event The event.
+         */
+        template <typename E>
+        void publish(const E &event) const
+        {
+            auto channel = findChannel<E>();
+            if (channel == nullptr)
+            {
+                return;
+            }
+
+            channel->deliver(event);
+        }
+
+        /**
+         * Queues an event, it is delivered by the next call to `flush`.
+         *
+         * Queued events are copied, so they must not reference data that does not live until the flush.
+         *
+         * @tparam E The event type.
+         * @param event The event.
+         */
+        template <typename E>
+        void enqueue(E event)
+        {
+            auto &channel = getChannel<E>();
+
+            if (channel.queue.empty())
+            {
+                queuedChannels.push_back(EventIdGenerator::id<E>);
+            }
+
+            channel.queue.push_back(std::move(event));
+        }
+
+        /**
+         * Delivers all queued events.
+         *
+         * Events are delivered grouped by type, in the order each type was first queued, events of one type are delivered in the order they were queued.
+         * Events queued by listeners during the flush are delivered by the next flush, unless their type still has undelivered events in this one.
+         */
+        void flush();
+
+        /**
+         * Drops all queued events without delivering them.
+         */
+        void clearQueue();
+
+        /**
+         * Gets the number of queued events.
+         *
+         * @returns The number of queued events.
+         */
+        size_t getQueuedCount() const;
+
+    private:
+        template <typename E>
+        struct Listener
+        {
+            ListenerId id;
+
+            /**
+             * Calls the listener, the member function for member listeners and the callback otherwise.
+             */
+            void (*invoke)(const Listener &listener, const E &event);
+
+            void *instance;
+            std::function<void(const E &)> callback;
+        };
+
+        struct ChannelBase
+        {
+            virtual ~ChannelBase() = default;
+
+            /**
+             * Delivers the queued events and clears the queue.
+             */
+            virtual void flush() = 0;
+
+            virtual void clearQueue() = 0;
+
+            virtual size_t getQueuedCount() const = 0;
+        };
+
+        template <typename E>
+        struct Channel final : ChannelBase
+        {
+            std::vector<Listener<E>> listeners;
+            std::vector<E> queue;
+
+            /**
+             * The queue being delivered, kept so its allocation is reused between flushes.
+             */
+            std::vector<E> delivering;
+
+            /**
+             * Listeners subscribed while an event is being delivered, they are added once delivery finishes.
+             *
+             * Adding them straight away could reallocate the listeners while one of them is running.
+             */
+            std::vector<Listener<E>> subscribedDuringDelivery;
+
+            /**
+             * The number of deliveries in progress, more than one when a listener publishes the event it is listening to.
+             */
+            size_t deliveryDepth = 0;
+
+            void add(Listener<E> listener)
+            {
+                if (deliveryDepth > 0)
+                {
+                    subscribedDuringDelivery.push_back(std::move(listener));
+                }
+                else
+                {
+                    listeners.push_back(std::move(listener));
+                }
+            }
+
+            void remove(ListenerId listenerId)
+            {
+                for (auto *list : {&listeners, &subscribedDuringDelivery})
+                {
+                    for (auto it = list->begin(); it != list->end(); ++it)
+                    {
+                        if (it->id == listenerId)
+                        {
+                            list->erase(it);
+                            return;
+                        }
+                    }
+                }
+            }
+
+            void deliver(const E &event)
+            {
+                deliveryDepth++;
+
+                for (auto &listener : listeners)
+                {
+                    listener.invoke(listener, event);
+                }
+
+                deliveryDepth--;
+
+                if (deliveryDepth == 0 && !subscribedDuringDelivery.empty())
+                {
+                    listeners.insert(listeners.end(), std::make_move_iterator(subscribedDuringDelivery.begin()), std::make_move_iterator(subscribedDuringDelivery.end()));
+                    subscribedDuringDelivery.clear();
+                }
+            }
+
+            void flush() override
+            {
+                delivering.swap(queue);
+
+                for (auto &event : delivering)
+                {
+                    deliver(event);
+                }
+
+                delivering.clear();
+            }
+
+            void clearQueue() override
+            {
+                queue.clear();
+            }
+
+            size_t getQueuedCount() const override
+            {
+                return queue.size();
+            }
+        };
+
+        /**
+         * The channel of each event type, indexed by event ID, nullptr for event types without a channel.
+         */
+        std::vector<ChannelBase *> channels;
+
+        /**
+         * The IDs of the channels with queued events, in the order they were first queued.
+         */
+        std::vector<EventId> queuedChannels;
+
+        /**
+         * The channels being flushed, kept so its allocation is reused between flushes.
+         */
+        std::vector<EventId> flushingChannels;
+
+        ListenerId nextListenerId = 1;
+
+        template <typename E>
+        static void invokeCallback(const Listener<E> &listener, const E &event)
+        {
+            listener.callback(event);
+        }
+
+        template <typename E, typename Class, auto Method>
+        static void invokeMethod(const Listener<E> &listener, const E &event)
+        {
+            (static_cast<Class *>(listener.instance)->*Method)(event);
+        }
+
+        /**
+         * Gets the channel of an event type, creating it if it does not exist.
+         */
+        template <typename E>
+        Channel<E> &getChannel()
+        {
+            auto eventId = EventIdGenerator::id<E>;
+
+            if (eventId >= channels.size())
+            {
+                channels.resize(eventId + 1, nullptr);
+            }
+
+            if (channels[eventId] == nullptr)
+            {
+                channels[eventId] = new Channel<E>();
+            }
+
+            return *static_cast<Channel<E> *>(channels[eventId]);
+        }
+
+        /**
+         * Gets the channel of an event type, nullptr if it does not exist.
+         */
+        template <typename E>
+        Channel<E> *findChannel() const
+        {
+            auto eventId = EventIdGenerator::id<E>;
+
+            if (eventId >= channels.size())
+            {
+                return nullptr;
+            }
+
+            return static_cast<Channel<E> *>(channels[eventId]);
+        }
+    };
+}
\ No newline at end of file
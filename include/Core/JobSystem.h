@@ -0,0 +1,293 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include <utility>
+
+namespace Core
+{
+    /**
+     * A job system runs jobs on a pool of worker threads.
+     *
+     * Every worker has its own queue of jobs. A worker runs the newest job in its own queue first,
+     * and when its queue is empty it steals the oldest job from another worker's queue.
+     *
+     * Jobs are submitted with a counter, and `wait` blocks until every job submitted with the counter has finished.
+     * The thread calling `wait` runs queued jobs while it waits, so jobs can safely submit and wait on other jobs,
+     * and a job system with no workers runs all jobs on the calling thread.
+     *
+     * A job can depend on a counter with `submitAfter`, it is then only queued once every job of that counter has finished.
+     * This can be used to chain jobs into a graph without blocking any thread.
+     *
+     * If a job throws, the first exception thrown by a job of a counter is rethrown from `wait` for that counter.
+     *
+     * A job system cannot be copied or moved.
+     */
+    class JobSystem
+    {
+    public:
+        /**
+         * Tracks a group of submitted jobs.
+         *
+         * A counter must outlive the jobs submitted with it, so it should always be waited on.
+         */
+        class Counter
+        {
+        public:
+            Counter() = default;
+
+            Counter(const Counter &other) = delete;
+
+            Counter &operator=(const Counter &other) = delete;
+
+            /**
+             * Returns whether or not all the jobs submitted with the counter have finished.
+             *
+             * @returns Whether or not all the jobs have finished.
+             */
+            bool isDone() const
+            {
+                return unfinishedJobs.load(std::memory_order_acquire) == 0;
+            }
+
+        private:
+            friend class JobSystem;
+
+            std::atomic<size_t> unfinishedJobs = 0;
+
+            /**
+             * Guards the exception and continuations.
+             *
+             * The last job to finish decrements the counter while holding this, so a counter is safe to destroy once it has been locked after finishing.
+             */
+            std::mutex mutex;
+            std::exception_ptr exception = nullptr;
+
+            /**
+             * The jobs to queue once the counter has finished.
+             */
+            std::vector<std::pair<std::function<void()>, Counter *>> continuations;
+        };
+
+        /**
+         * Creates a new job system.
+         *
+         * Pinning workers to cores reduces cache misses from threads migrating between cores, but can hurt if other
+         * processes are competing for the same cores. Worker i is pinned to core i + 1, leaving core 0 for the main thread.
+         * Pinning is only supported on linux and windows, elsewhere it is ignored.
+         *
+         * @param workerCount The number of worker threads to create, by default this is `getDefaultWorkerCount()`.
+         * @param pinWorkers Whether or not to pin each worker thread to its own core.
+         */
+        JobSystem(unsigned int workerCount = getDefaultWorkerCount(), bool pinWorkers = false);
+
+        /**
+         * Destroys the job system.
+         *
+         * Runs any jobs still queued and then joins the worker threads.
+         */
+        ~JobSystem();
+
+        JobSystem(const JobSystem &other) = delete;
+
+        JobSystem &operator=(const JobSystem &other) = delete;
+
+        /**
+         * Submits a job to be run by the job system.
+         *
+         * When called from a worker the job is pushed to the worker's own queue, otherwise the jobs are spread over the workers' queues.
+         * If the job system has no workers, the job will be run immediately on the calling thread.
+         *
+         * @param job The job to run.
+         * @param counter The counter to track the job with.
+         */
+        void submit(std::function<void()> job, Counter &counter);
+
+        /**
+         * Submits a job to be run once every job of the given dependency has finished.
+         *
+         * The job is tracked by `counter` immediately, so waiting on `counter` also waits for the dependency.
+         * The job runs even if a job of the dependency threw.
+         *
+         * The dependency must not be destroyed before it has finished.
+         *
+         * @param dependency The counter the job depends on.
+         * @param job The job to run.
+         * @param counter The counter to track the job with.
+         */
+        void submitAfter(Counter &dependency, std::function<void()> job, Counter &counter);
+
+        /**
+         * Calls the given function for chunks of the range [begin, end) in parallel and waits for them to finish.
+         *
+         * The range is split into chunks of at most `grainSize` indices, each chunk is one job.
+         * The calling thread runs chunks too, so this can be used from inside of jobs.
+         *
+         * @param begin The first index.
+         * @param end The index after the last index.
+         * @param grainSize The number of indices in each chunk.
+         * @param func The function to call, with the signature `void(size_t begin, size_t end)`.
+         *
+         * @throws std::invalid_argument If grainSize is 0.
+         * @throws The first exception thrown by the function, once every chunk has finished.
+         */
+        template <typename Func>
+        void parallelFor(size_t begin, size_t end, size_t grainSize, Func &&func)
+        {
+            if (grainSize == 0)
+            {
+                throw std::invalid_argument("JobSystem (parallelFor): Grain size must be greater than 0.");
+            }
+
+            if (end <= begin)
+            {
+                return;
+            }
+
+            // a single chunk is run directly, avoiding the cost of a job
+            if (end - begin <= grainSize || workers.empty())
+            {
+                func(begin, end);
+                return;
+            }
+
+            Counter counter;
+
+            for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize)
+            {
+                size_t chunkEnd = std::min(chunkBegin + grainSize, end);
+
+                submit([&func, chunkBegin, chunkEnd]()
+                       { func(chunkBegin, chunkEnd); },
+                       counter);
+            }
+
+            wait(counter);
+        }
+
+        /**
+         * Waits for all the jobs submitted with the given counter to finish.
+         *
+         * The calling thread will run queued jobs while it waits.
+         *
+         * @param counter The counter to wait on.
+         *
+         * @throws The first exception thrown by a job submitted with the counter.
+         */
+        void wait(Counter &counter);
+
+        /**
+         * Gets the number of worker threads.
+         *
+         * @returns The number of worker threads.
+         */
+        unsigned int getWorkerCount() const;
+
+        /**
+         * Gets the default number of worker threads.
+         *
+         * This is one less than the number of hardware threads, as the thread calling `wait` also runs jobs.
+         *
+         * On emscripten this is always 0.
+         *
+         * @returns The default number of worker threads.
+         */
+        static unsigned int getDefaultWorkerCount();
+
+    private:
+        struct Job
+        {
+            std::function<void()> func;
+            Counter *counter;
+        };
+
+        /**
+         * The queue of a worker.
+         *
+         * The owning worker pushes and pops jobs at the back, other threads steal from the front.
+         */
+        struct WorkerQueue
+        {
+            std::deque<Job> jobs;
+            std::mutex mutex;
+        };
+
+        std::vector<std::thread> workers;
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+
+        /**
+         * The queue jobs submitted from outside of the workers are pushed to next.
+         */
+        std::atomic<size_t> nextQueue = 0;
+
+        /**
+         * The number of jobs in all queues.
+         */
+        std::atomic<size_t> queuedJobs = 0;
+
+        bool stopping = false;
+
+        /**
+         * Used to put idle threads to sleep until a job is queued or a counter finishes.
+         */
+        std::mutex sleepMutex;
+        std::condition_variable wake;
+
+        /**
+         * The main loop of a worker thread.
+         *
+         * @param index The index of the worker.
+         */
+        void workerLoop(size_t index);
+
+        /**
+         * Takes a job to run.
+         *
+         * Takes the newest job from the calling worker's own queue if it has one, otherwise steals the oldest job from another queue.
+         *
+         * @param job The job that was taken.
+         *
+         * @returns Whether or not a job was taken.
+         */
+        bool takeJob(Job &job);
+
+        /**
+         * Runs a job and marks it as finished on its counter.
+         *
+         * @param job The job to run.
+         */
+        void runJob(Job &job);
+
+        /**
+         * Pushes a job to a worker queue and wakes a sleeping thread.
+         *
+         * If the job system has no workers, the job is run immediately.
+         *
+         * @param job The job to queue.
+         */
+        void enqueue(Job job);
+
+        /**
+         * Pins the calling thread to the given core.
+         *
+         * @param core The index of the core.
+         */
+        static void pinCurrentThread(unsigned int core);
+
+        /**
+         * Gets the index of the calling thread's worker queue in this job system.
+         *
+         * @returns The index or -1 if the calling thread is not one of this job system's workers.
+         */
+        long long getCurrentWorkerIndex() const;
+    };
+}
\ No newline at end of file
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "Timestep.h"
-#include "Subject.h"
+#include "EventBus.h"
 
 #define SDL_MAIN_HANDLED
 #include <SDL2/SDL.h>
@@ -25,7 +25,16 @@ namespace Core
         WINDOWED_FULLSCREEN
     };
 
-    const std::string WindowPollEventName = "poll";
+    /**
+     * Published on the window's event bus every time the window polls for events.
+     */
+    struct WindowPollEvent
+    {
+        /**
+         * The events that were polled.
+         */
+        const std::vector<SDL_Event> &events;
+    };
 
     /**
      * The window is responsible for creating and managing the window.
@@ -35,8 +44,10 @@ namespace Core
      * @note By default the window is shown.
      *
      * @note By default the window is resizable.
+     *
+     * The window publishes a WindowPollEvent on its event bus every time it polls for events.
      */
-    class Window : public Subject<const std::vector<SDL_Event> &>
+    class Window
     {
     public:
         /**
@@ -91,6 +102,15 @@ namespace Core
          */
         const std::vector<SDL_Event> &getEvents() const;
 
+        /**
+         * Gets the event bus of the window.
+         *
+         * Events queued on it are delivered when the window next polls for events, which is the end of the frame.
+         *
+         * @returns The event bus of the window.
+         */
+        EventBus &getEventBus();
+
         /**
          * Shows the window.
          */
@@ -252,6 +272,8 @@ namespace Core
 
         std::vector<SDL_Event> events;
 
+        EventBus eventBus;
+
         /**
          * OpenGL ES 3.0 for webgl 2.0 matching.
          */
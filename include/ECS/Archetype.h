@@ -0,0 +1,188 @@
+#pragma once
+
+#include "Entity.h"
+#include "Component.h"
+#include "ComponentMask.h"
+
+#include <vector>
+#include <unordered_map>
+
+namespace ECS
+{
+    /**
+     * An archetype is a table of all the entities that share the exact same set of components (their signature).
+     *
+     * The entities of an archetype are stored tightly packed in a single vector, so a query for a set of components
+     * can be answered by scanning the entities of every archetype whose signature contains the components, without any hashing.
+     *
+     * Archetypes are linked to each other through add and remove edges, which cache the archetype an entity moves to
+     * when a component is added to or removed from it.
+     */
+    class Archetype
+    {
+    public:
+        /**
+         * Creates a new archetype.
+         *
+         * @param signature The sorted component ids of the archetype.
+         */
+        Archetype(std::vector<ComponentId> signature);
+
+        /**
+         * Destroys the archetype.
+         */
+        ~Archetype();
+
+        Archetype(const Archetype &other) = delete;
+
+        Archetype &operator=(const Archetype &other) = delete;
+
+        /**
+         * Adds an entity to the archetype.
+         *
+         * @param entity The entity to add.
+         *
+         * @returns The row of the entity in the archetype.
+         */
+        size_t add(Entity entity);
+
+        /**
+         * Removes the entity at the given row from the archetype.
+         *
+         * The last entity in the archetype is swapped into the removed entity's row.
+         *
+         * @param row The row of the entity to remove.
+         *
+         * @returns Whether or not an entity was swapped into the row, in which case `getEntities()[row]` is the moved entity.
+         */
+        bool remove(size_t row);
+
+        /**
+         * Removes all entities from the archetype.
+         */
+        void clear();
+
+        /**
+         * Returns whether or not the archetype's signature contains the given component.
+         *
+         * @param componentId The ID of the component.
+         *
+         * @returns Whether or not the archetype's signature contains the component.
+         */
+        bool has(ComponentId componentId) const
+        {
+            return mask.test(componentId);
+        }
+
+        /**
+         * Returns whether or not the archetype's signature contains all of the given components.
+         *
+         * @param componentIds The sorted IDs of the components.
+         *
+         * @returns Whether or not the archetype's signature contains all of the components.
+         */
+        bool hasAll(const std::vector<ComponentId> &componentIds) const;
+
+        /**
+         * Returns whether or not the archetype's signature contains all of the components in the given mask.
+         *
+         * @param componentMask The mask of the components.
+         *
+         * @returns Whether or not the archetype's signature contains all of the components.
+         */
+        bool hasAll(const ComponentMask &componentMask) const
+        {
+            return mask.contains(componentMask);
+        }
+
+        /**
+         * Gets the signature of the archetype.
+         *
+         * @returns The sorted component ids of the archetype.
+         */
+        const std::vector<ComponentId> &getSignature() const;
+
+        /**
+         * Gets the signature of the archetype as a mask.
+         *
+         * Every entity in the archetype has exactly these components, so this is the component mask of each of its entities.
+         *
+         * @returns The mask of the archetype's components.
+         */
+        const ComponentMask &getMask() const;
+
+        /**
+         * Gets the entities in the archetype.
+         *
+         * @returns The entities in the archetype.
+         */
+        const std::vector<Entity> &getEntities() const;
+
+        /**
+         * Returns the number of entities in the archetype.
+         *
+         * @returns The number of entities in the archetype.
+         */
+        size_t size() const;
+
+        /**
+         * Gets the archetype an entity moves to when the given component is added to it.
+         *
+         * @param componentId The ID of the component.
+         *
+         * @returns The archetype or nullptr if the edge has not been created yet.
+         */
+        Archetype *getAddEdge(ComponentId componentId) const;
+
+        /**
+         * Sets the archetype an entity moves to when the given component is added to it.
+         *
+         * @param componentId The ID of the component.
+         * @param archetype The archetype.
+         */
+        void setAddEdge(ComponentId componentId, Archetype *archetype);
+
+        /**
+         * Gets the archetype an entity moves to when the given component is removed from it.
+         *
+         * @param componentId The ID of the component.
+         *
+         * @returns The archetype or nullptr if the edge has not been created yet.
+         */
+        Archetype *getRemoveEdge(ComponentId componentId) const;
+
+        /**
+         * Sets the archetype an entity moves to when the given component is removed from it.
+         *
+         * @param componentId The ID of the component.
+         * @param archetype The archetype.
+         */
+        void setRemoveEdge(ComponentId componentId, Archetype *archetype);
+
+    private:
+        /**
+         * The sorted component ids of the archetype.
+         */
+        std::vector<ComponentId> signature;
+
+        /**
+         * The signature as a mask.
+         */
+        ComponentMask mask;
+
+        /**
+         * The entities in the archetype.
+         */
+        std::vector<Entity> entities;
+
+        /**
+         * The archetypes entities move to when a component is added.
+         */
+        std::unordered_map<ComponentId, Archetype *> addEdges;
+
+        /**
+         * The archetypes entities move to when a component is removed.
+         */
+        std::unordered_map<ComponentId, Archetype *> removeEdges;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Entity.h"
+#include "Component.h"
+#include "ComponentMask.h"
+#include "PagedIndexArray.h"
+
+#include <vector>
+#include <cstdint>
+
+namespace ECS
+{
+    /**
+     * A cached view of the entities with a set of components.
+     *
+     * The view is kept up to date by the registry as components are added and removed, entities are swap removed from the vectors using their index maps.
+     *
+     * Cached views are owned by the registry and live as long as it does, so pointers to them stay valid.
+     *
+     * @param componentIds The sorted IDs of the components in the view.
+     * @param mask The components in the view as a mask.
+     * @param timestamp The timestamp of the cache.
+     * @param entities The entities in the cache.
+     * @param indices The index of each entity in `entities`.
+     * @param addedSinceTimestamp The entities that have been added since the timestamp.
+     * @param addedIndices The index of each entity in `addedSinceTimestamp`.
+     * @param removedSinceTimestamp The entities that have been removed since the timestamp.
+     */
+    struct CachedView
+    {
+        std::vector<ComponentId> componentIds;
+        ComponentMask mask;
+        uint64_t timestamp = 0;
+        std::vector<Entity> entities;
+        PagedIndexArray indices;
+        std::vector<Entity> addedSinceTimestamp;
+        PagedIndexArray addedIndices;
+        std::vector<Entity> removedSinceTimestamp;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "Entity.h"
+#include "Component.h"
+#include "Registry.h"
+
+#include <vector>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace ECS
+{
+    /**
+     * A command buffer records structural changes to a registry and applies them later, at a point where nothing is iterating the registry.
+     *
+     * Creating and destroying entities, and adding and removing components, can be recorded from any thread, e.g. from systems running
+     * in parallel or from contact callbacks fired during the physics step.
+     *
+     * When applied, the commands are coalesced and applied in batches:
+     *
+     * - Entities are created first, so components can be added to entities created by the buffer.
+     * - Only the last add or remove of a component on an entity has an effect.
+     * - Adds and removes are grouped by component, so each component pool and its cached views are updated together.
+     * - Entities are destroyed last in a single batch, components added to them by the buffer are never added.
+     *   Entities both created and destroyed by the buffer are never created.
+     *
+     * Commands for entities which no longer exist when the buffer is applied are ignored.
+     *
+     * A command buffer cannot be copied or moved.
+     */
+    class CommandBuffer
+    {
+    public:
+        /**
+         * Creates a new command buffer.
+         *
+         * @param registry The registry the commands are applied to.
+         */
+        CommandBuffer(Registry *registry);
+
+        /**
+         * Destroys the command buffer.
+         *
+         * Commands which have not been applied are discarded.
+         */
+        ~CommandBuffer();
+
+        CommandBuffer(const CommandBuffer &other) = delete;
+
+        CommandBuffer &operator=(const CommandBuffer &other) = delete;
+
+        /**
+         * Records the creation of an entity.
+         *
+         * The entity id is reserved immediately, so components can be added to it through the buffer,
+         * but the entity does not exist in the registry until the buffer is applied.
+         *
+         * @returns The entity that will be created.
+         *
+         * @throws std::runtime_error If there are no more entity ids available.
+         */
+        Entity create();
+
+        /**
+         * Records the destruction of an entity and all its components.
+         *
+         * @param entity The entity to destroy.
+         */
+        void destroy(Entity entity);
+
+        /**
+         * Records adding a component to the given entity.
+         *
+         * The component is moved into the buffer, and moved into the registry when the buffer is applied.
+         *
+         * @tparam T The type of component.
+         *
+         * @param entity The entity to add the component to.
+         * @param component The component to add.
+         */
+        template <typename T>
+        void add(Entity entity, T component)
+        {
+            if constexpr (std::is_copy_constructible_v<T>)
+            {
+                record(entity, ComponentIdGenerator::id<T>, [component = std::move(component)](Registry &registry, Entity entity) mutable
+                       { registry.add<T>(entity, std::move(component)); });
+            }
+            else
+            {
+                // std::function needs a copyable callable, so a move-only component is held through a shared pointer
+                record(entity, ComponentIdGenerator::id<T>, [component = std::make_shared<T>(std::move(component))](Registry &registry, Entity entity)
+                       { registry.add<T>(entity, std::move(*component)); });
+            }
+        }
+
+        /**
+         * Records removing a component from the given entity.
+         *
+         * @tparam T The type of component.
+         *
+         * @param entity The entity to remove the component from.
+         */
+        template <typename T>
+        void remove(Entity entity)
+        {
+            record(entity, ComponentIdGenerator::id<T>, [](Registry &registry, Entity entity)
+                   { registry.remove<T>(entity); });
+        }
+
+        /**
+         * Applies the recorded commands to the registry and clears the buffer.
+         *
+         * This must not be called while the registry is being iterated. Commands recorded while applying are kept for the next call.
+         *
+         * @throws std::runtime_error If a command fails, commands after it in the batch are discarded.
+         */
+        void apply();
+
+        /**
+         * Discards the recorded commands.
+         *
+         * Entity ids reserved by `create` are given back to the registry.
+         */
+        void clear();
+
+        /**
+         * Returns whether or not there are no recorded commands.
+         *
+         * @returns Whether or not there are no recorded commands.
+         */
+        bool empty();
+
+    private:
+        /**
+         * An add or remove of a component.
+         */
+        struct Command
+        {
+            Entity entity;
+            ComponentId componentId;
+            std::function<void(Registry &, Entity)> apply;
+        };
+
+        Registry *registry;
+
+        /**
+         * Guards the recorded commands.
+         */
+        std::mutex mutex;
+
+        std::vector<Entity> created;
+        std::vector<Entity> destroyed;
+        std::vector<Command> commands;
+
+        /**
+         * Records an add or remove of a component.
+         *
+         * @param entity The entity.
+         * @param componentId The id of the component.
+         * @param apply Applies the command to the registry.
+         */
+        void record(Entity entity, ComponentId componentId, std::function<void(Registry &, Entity)> apply);
+    };
+}
\ No newline at end of file
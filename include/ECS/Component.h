@@ -2,6 +2,8 @@
 
 #include "../Utility/TypeHelpers.h"
 
+#include <cstdint>
+
 namespace ECS
 {
     using ComponentId = unsigned long long;
@@ -13,13 +15,23 @@ namespace ECS
     {
     public:
         /**
-         * Generates a unique id using the hash code of the type.
+         * Generates a dense id for the type, the registry indexes its component pools with it.
+         *
+         * Ids are handed out in the order component types are first used, so they can differ between runs and must not be persisted (see `hash`).
          *
-         * NOTE: Switched to using the hash code of the type as the id instead of incrementing a static variable.
+         * NOTE: The id is looked up by the name of the type instead of incrementing a static variable.
          *       This is because different dlls and exes will generate their own version of the template and
          *       therefore have different ids for the same component.
          */
         template <typename T>
-        inline static const ComponentId id = remi::generateTypeId(typeid(T).name());
+        inline static const ComponentId id = remi::generateTypeIndex(typeid(T).name());
+
+        /**
+         * Generates an id using the hash code of the type, which is the same in every run.
+         *
+         * This identifies components in snapshots.
+         */
+        template <typename T>
+        inline static const uint64_t hash = remi::generateTypeId(typeid(T).name());
     };
 }
\ No newline at end of file
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "Component.h"
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace ECS
+{
+    /**
+     * A set of components stored as a bitmask, one bit per component ID.
+     *
+     * Component IDs are dense (see ComponentIdGenerator), so the mask only needs as many bits as there are component types.
+     * Checking whether a set of components contains another set is a few word operations, without any hashing or searching.
+     *
+     * The mask grows to fit the largest ID set in it, bits past its end are treated as not set.
+     */
+    class ComponentMask
+    {
+    public:
+        /**
+         * Creates an empty mask.
+         */
+        ComponentMask() = default;
+
+        /**
+         * Creates a mask of the given components.
+         *
+         * @param componentIds The IDs of the components.
+         */
+        ComponentMask(const std::vector<ComponentId> &componentIds)
+        {
+            for (auto componentId : componentIds)
+            {
+                set(componentId);
+            }
+        }
+
+        /**
+         * Adds a component to the mask.
+         *
+         * @param componentId The ID of the component.
+         */
+        void set(ComponentId componentId)
+        {
+            size_t word = componentId / 64;
+
+            if (word >= words.size())
+            {
+                words.resize(word + 1, 0);
+            }
+
+            words[word] |= uint64_t(1) << (componentId % 64);
+        }
+
+        /**
+         * Removes a component from the mask.
+         *
+         * @param componentId The ID of the component.
+         */
+        void reset(ComponentId componentId)
+        {
+            size_t word = componentId / 64;
+
+            if (word < words.size())
+            {
+                words[word] &= ~(uint64_t(1) << (componentId % 64));
+            }
+        }
+
+        /**
+         * Returns whether or not the mask has the given component.
+         *
+         * @param componentId The ID of the component.
+         *
+         * @returns Whether or not the mask has the component.
+         */
+        bool test(ComponentId componentId) const
+        {
+            size_t word = componentId / 64;
+
+            return word < words.size() && (words[word] >> (componentId % 64)) & 1;
+        }
+
+        /**
+         * Returns whether or not the mask has every component of the other mask, i.e. `(mask & other) == other`.
+         *
+         * @param other The other mask.
+         *
+         * @returns Whether or not the mask contains the other mask.
+         */
+        bool contains(const ComponentMask &other) const
+        {
+            for (size_t i = 0; i < other.words.size(); i++)
+            {
+                uint64_t word = i < words.size() ? words[i] : 0;
+
+                if ((word & other.words[i]) != other.words[i])
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+    private:
+        /**
+         * The bits of the mask, bit `id % 64` of word `id / 64` is set for each component.
+         */
+        std::vector<uint64_t> words;
+    };
+}
\ No newline at end of file
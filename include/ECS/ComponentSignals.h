@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Entity.h"
+
+namespace ECS
+{
+    class Registry;
+
+    /**
+     * Published on the registry's signal bus after a component of type T is added to an entity which did not have one, see `Registry::getSignals`.
+     *
+     * Also published for the components of prefab instances and of entities loaded from a snapshot.
+     *
+     * @tparam T The type of component.
+     */
+    template <typename T>
+    struct ComponentConstructed
+    {
+        Entity entity;
+    };
+
+    /**
+     * Published on the registry's signal bus after a component of type T is replaced by adding it to an entity which already has one.
+     *
+     * Modifying a component through `get` does not publish this, use `changed` for that.
+     *
+     * @tparam T The type of component.
+     */
+    template <typename T>
+    struct ComponentUpdated
+    {
+        Entity entity;
+    };
+
+    /**
+     * Published on the registry's signal bus before a component of type T is removed from an entity, either by `remove` or by destroying the entity.
+     *
+     * The component can still be read by the listeners.
+     *
+     * @tparam T The type of component.
+     */
+    template <typename T>
+    struct ComponentDestroyed
+    {
+        Entity entity;
+    };
+
+    /**
+     * Published on the registry's signal bus when the registry is destroyed, so listeners which may outlive it know not to unsubscribe from it.
+     */
+    struct RegistryDestroyed
+    {
+        const Registry *registry;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,610 @@
+#pragma once
+
+#include <vector>
+#include <tuple>
+#include <utility>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace ECS
+{
+    /**
+     * Lists the fields of a component which are stored in struct of arrays layout.
+     *
+     * @tparam Fields Pointers to the data members of the component, e.g. `&Particle::position`.
+     */
+    template <auto... Fields>
+    struct SoAFields
+    {
+    };
+
+    /**
+     * The storage layout of a component type.
+     *
+     * By default components are stored as an array of structs, every component is stored whole in a single dense vector.
+     *
+     * A component type can opt in to struct of arrays layout by specializing this with a `Fields` type listing its data members:
+     *
+     * ```
+     * template <>
+     * struct ECS::ComponentStorage<Particle>
+     * {
+     *     using Fields = ECS::SoAFields<&Particle::position, &Particle::velocity>;
+     * };
+     * ```
+     *
+     * Each listed member is then stored in its own dense vector, so a loop which only touches one member only pulls that member through the cache.
+     * Members which are not listed are not stored, so every member which is part of the component's state must be listed.
+     *
+     * The component must be default constructible and its listed members must be public and copy assignable, i.e. not C arrays.
+     *
+     * Because the component is not stored whole, a component with struct of arrays layout is accessed through an `SoARef` rather than a reference.
+     * This is what `Registry::get`, `Registry::add`, `Registry::each` and `Registry::parallelEach` hand out for such components.
+     *
+     * @tparam T The type of component.
+     */
+    template <typename T>
+    struct ComponentStorage
+    {
+        using Fields = void;
+    };
+
+    /**
+     * Whether or not the given component type is stored in struct of arrays layout.
+     *
+     * @tparam T The type of component.
+     */
+    template <typename T>
+    inline constexpr bool isSoAComponent = !std::is_void_v<typename ComponentStorage<T>::Fields>;
+
+    /**
+     * Whether or not the given component type is a tag, i.e. an empty type used only to mark entities, such as `Rendering::ActiveCamera`.
+     *
+     * Every object of an empty type is the same, so tags are not stored at all, their sparse set only keeps the ids of the entities which have them.
+     * A tag must be default constructible, and constructing, copying and destroying it must have no side effects, as the stored objects are never made.
+     *
+     * @tparam T The type of component.
+     */
+    template <typename T>
+    inline constexpr bool isTagComponent = std::is_empty_v<T> && std::is_default_constructible_v<T> && !isSoAComponent<T>;
+
+    template <typename M>
+    struct MemberPointerTraits;
+
+    template <typename C, typename F>
+    struct MemberPointerTraits<F C::*>
+    {
+        using Field = F;
+    };
+
+    /**
+     * The type of the data member the given member pointer points to.
+     *
+     * @tparam Field The member pointer.
+     */
+    template <auto Field>
+    using FieldType = std::remove_cv_t<typename MemberPointerTraits<decltype(Field)>::Field>;
+
+    /**
+     * Gets whether or not two member pointers point to the same member.
+     *
+     * Member pointers of different types are never the same.
+     *
+     * @tparam A The first member pointer.
+     * @tparam B The second member pointer.
+     *
+     * @returns Whether or not the member pointers are the same.
+     */
+    template <auto A, auto B>
+    constexpr bool isSameField()
+    {
+        if constexpr (std::is_same_v<decltype(A), decltype(B)>)
+        {
+            return A == B;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    /**
+     * Gets the index of a member pointer in the given list of member pointers.
+     *
+     * @tparam Field The member pointer to find.
+     * @tparam Fields The member pointers to search.
+     *
+     * @returns The index of the member pointer or the number of member pointers if it is not in the list.
+     */
+    template <auto Field, auto... Fields>
+    constexpr size_t fieldIndex()
+    {
+        constexpr bool matches[] = {isSameField<Field, Fields>()..., false};
+
+        for (size_t i = 0; i < sizeof...(Fields); i++)
+        {
+            if (matches[i])
+            {
+                return i;
+            }
+        }
+
+        return sizeof...(Fields);
+    }
+
+    template <typename T, typename Fields = typename ComponentStorage<T>::Fields>
+    class DenseStorage;
+
+    /**
+     * A reference to a component stored in struct of arrays layout.
+     *
+     * The reference is a cheap handle (a pointer and an index) and should be passed by value.
+     * It is invalidated by anything that invalidates a reference to a component, i.e. adding or removing components of the same type.
+     *
+     * @tparam T The type of component.
+     * @tparam Const Whether or not the component can only be read through the reference.
+     */
+    template <typename T, bool Const = false, typename Fields = typename ComponentStorage<T>::Fields>
+    class SoARef;
+
+    template <typename T, bool Const, auto... Fields>
+    class SoARef<T, Const, SoAFields<Fields...>>
+    {
+    public:
+        using Columns = std::conditional_t<Const, const std::tuple<std::vector<FieldType<Fields>>...>, std::tuple<std::vector<FieldType<Fields>>...>>;
+
+        /**
+         * Creates a reference to the component at the given index of the columns.
+         *
+         * @param columns The columns of the dense storage.
+         * @param index The index of the component.
+         */
+        SoARef(Columns *columns, size_t index) : columns(columns), index(index)
+        {
+        }
+
+        /**
+         * Gets a member of the component.
+         *
+         * @tparam Field The member pointer, e.g. `&Particle::position`.
+         *
+         * @returns A reference to the member, or the vector's proxy for bool members.
+         */
+        template <auto Field>
+        decltype(auto) field() const
+        {
+            constexpr size_t i = fieldIndex<Field, Fields...>();
+            static_assert(i < sizeof...(Fields), "SoARef (field): Field is not stored by the component's storage.");
+
+            return std::get<i>(*columns)[index];
+        }
+
+        /**
+         * Copies the component out of the columns.
+         *
+         * @returns A copy of the component.
+         */
+        T load() const
+        {
+            T component{};
+            ((component.*Fields = field<Fields>()), ...);
+
+            return component;
+        }
+
+        /**
+         * Copies the given component into the columns.
+         *
+         * @param component The component to copy.
+         */
+        void store(const T &component) const
+            requires(!Const)
+        {
+            ((field<Fields>() = component.*Fields), ...);
+        }
+
+        /**
+         * Copies the component out of the columns.
+         *
+         * @returns A copy of the component.
+         */
+        operator T() const
+        {
+            return load();
+        }
+
+        /**
+         * Copies the given component into the columns.
+         *
+         * @param component The component to copy.
+         *
+         * @returns This reference.
+         */
+        const SoARef &operator=(const T &component) const
+            requires(!Const)
+        {
+            store(component);
+            return *this;
+        }
+
+        /**
+         * Gets the index of the component in the columns.
+         *
+         * @returns The index of the component.
+         */
+        size_t getIndex() const
+        {
+            return index;
+        }
+
+    private:
+        Columns *columns;
+        size_t index;
+    };
+
+    /**
+     * The dense vector of a sparse set, storing components as an array of structs.
+     *
+     * @tparam T The type of component.
+     */
+    template <typename T>
+    class DenseStorage<T, void>
+    {
+    public:
+        using Reference = T &;
+        using ConstReference = const T &;
+
+        /**
+         * Gets the item at the given index.
+         *
+         * @param index The index of the item.
+         *
+         * @returns A reference to the item.
+         */
+        Reference at(size_t index)
+        {
+            return data[index];
+        }
+
+        /**
+         * Gets the item at the given index for reading.
+         *
+         * @param index The index of the item.
+         *
+         * @returns A const reference to the item.
+         */
+        ConstReference at(size_t index) const
+        {
+            return data[index];
+        }
+
+        /**
+         * Overwrites the item at the given index.
+         *
+         * @param index The index of the item.
+         * @param item The new item.
+         */
+        void set(size_t index, T item)
+        {
+            data[index] = std::move(item);
+        }
+
+        /**
+         * Adds an item to the back.
+         *
+         * @param item The item to add.
+         */
+        void push_back(T item)
+        {
+            data.push_back(std::move(item));
+        }
+
+        /**
+         * Constructs an item in place at the back.
+         *
+         * @param args The arguments to construct the item with.
+         */
+        template <typename... Args>
+        void emplace_back(Args &&...args)
+        {
+            data.emplace_back(std::forward<Args>(args)...);
+        }
+
+        /**
+         * Swaps the items at the given indices.
+         *
+         * @param indexA The index of the first item.
+         * @param indexB The index of the second item.
+         */
+        void swap(size_t indexA, size_t indexB)
+        {
+            std::swap(data[indexA], data[indexB]);
+        }
+
+        /**
+         * Moves the item at the back into the given index and removes the back.
+         *
+         * @param index The index to overwrite.
+         */
+        void swapRemove(size_t index)
+        {
+            if (index != data.size() - 1)
+            {
+                data[index] = std::move(data.back());
+            }
+
+            data.pop_back();
+        }
+
+        /**
+         * Returns the number of items.
+         *
+         * @returns The number of items.
+         */
+        size_t size() const
+        {
+            return data.size();
+        }
+
+        /**
+         * Reserves capacity for the given number of items.
+         *
+         * @param capacity The number of items.
+         */
+        void reserve(size_t capacity)
+        {
+            data.reserve(capacity);
+        }
+
+        /**
+         * Removes all items.
+         */
+        void clear()
+        {
+            data.clear();
+        }
+
+        /**
+         * Replaces all items with items copied from raw memory.
+         *
+         * Only available for trivially copyable types. The memory does not have to be aligned.
+         *
+         * @param items The items to copy.
+         * @param count The number of items.
+         */
+        void assign(const std::byte *items, size_t count)
+            requires(std::is_trivially_copyable_v<T>)
+        {
+            data.resize(count);
+
+            if (count > 0)
+            {
+                std::memcpy(data.data(), items, count * sizeof(T));
+            }
+        }
+
+        /**
+         * Returns the vector of items.
+         *
+         * @returns The vector of items.
+         */
+        const std::vector<T> &getData() const
+        {
+            return data;
+        }
+
+    private:
+        std::vector<T> data;
+    };
+
+    /**
+     * The dense vector of a sparse set of tag components, which stores nothing but the number of items.
+     *
+     * Every item is handed out as a reference to the same object, which is fine as empty objects hold no state.
+     * Adding, removing and swapping items only updates the count, so no items are constructed, copied or moved.
+     *
+     * @tparam T The type of component.
+     */
+    template <typename T>
+        requires(isTagComponent<T>)
+    class DenseStorage<T, void>
+    {
+    public:
+        using Reference = T &;
+        using ConstReference = const T &;
+
+        Reference at(size_t)
+        {
+            return item;
+        }
+
+        ConstReference at(size_t) const
+        {
+            return item;
+        }
+
+        void set(size_t, T)
+        {
+        }
+
+        void push_back(T)
+        {
+            count++;
+        }
+
+        template <typename... Args>
+        void emplace_back(Args &&...)
+        {
+            count++;
+        }
+
+        void swap(size_t, size_t)
+        {
+        }
+
+        void swapRemove(size_t)
+        {
+            count--;
+        }
+
+        size_t size() const
+        {
+            return count;
+        }
+
+        void reserve(size_t)
+        {
+        }
+
+        void clear()
+        {
+            count = 0;
+        }
+
+        /**
+         * Sets the number of items, the memory of the items is not read as tags have no state.
+         *
+         * @param itemCount The number of items.
+         */
+        void assign(const std::byte *, size_t itemCount)
+        {
+            count = itemCount;
+        }
+
+    private:
+        size_t count = 0;
+
+        /**
+         * The object handed out for every item.
+         */
+        T item;
+    };
+
+    /**
+     * The dense vector of a sparse set, storing components as a struct of arrays.
+     *
+     * Each member listed in the component's storage trait is stored in its own vector (column), at the same index for the same component.
+     * It has the same interface as the array of structs storage, but hands out SoARefs instead of references.
+     *
+     * @tparam T The type of component.
+     * @tparam Fields The stored members.
+     */
+    template <typename T, auto... Fields>
+    class DenseStorage<T, SoAFields<Fields...>>
+    {
+        static_assert(sizeof...(Fields) > 0, "DenseStorage: A component with struct of arrays layout must store at least one field.");
+
+    public:
+        using Reference = SoARef<T>;
+        using ConstReference = SoARef<T, true>;
+
+        Reference at(size_t index)
+        {
+            return Reference(&columns, index);
+        }
+
+        ConstReference at(size_t index) const
+        {
+            return ConstReference(&columns, index);
+        }
+
+        void set(size_t index, T item)
+        {
+            ((std::get<columnIndex<Fields>()>(columns)[index] = std::move(item.*Fields)), ...);
+        }
+
+        void push_back(T item)
+        {
+            (std::get<columnIndex<Fields>()>(columns).push_back(std::move(item.*Fields)), ...);
+        }
+
+        /**
+         * Constructs an item and moves its fields to the back of the columns.
+         *
+         * The item is never stored whole, so it cannot be constructed in place.
+         *
+         * @param args The arguments to construct the item with.
+         */
+        template <typename... Args>
+        void emplace_back(Args &&...args)
+        {
+            push_back(T(std::forward<Args>(args)...));
+        }
+
+        void swap(size_t indexA, size_t indexB)
+        {
+            (swapColumn(std::get<columnIndex<Fields>()>(columns), indexA, indexB), ...);
+        }
+
+        /**
+         * Moves the item at the back into the given index and removes the back.
+         *
+         * @param index The index to overwrite.
+         */
+        void swapRemove(size_t index)
+        {
+            (swapRemoveColumn(std::get<columnIndex<Fields>()>(columns), index), ...);
+        }
+
+        size_t size() const
+        {
+            return std::get<0>(columns).size();
+        }
+
+        void reserve(size_t capacity)
+        {
+            (std::get<columnIndex<Fields>()>(columns).reserve(capacity), ...);
+        }
+
+        void clear()
+        {
+            (std::get<columnIndex<Fields>()>(columns).clear(), ...);
+        }
+
+        /**
+         * Gets the column storing the given member of every component.
+         *
+         * @tparam Field The member pointer.
+         *
+         * @returns The column.
+         */
+        template <auto Field>
+        std::vector<FieldType<Field>> &getColumn()
+        {
+            constexpr size_t i = fieldIndex<Field, Fields...>();
+            static_assert(i < sizeof...(Fields), "DenseStorage (getColumn): Field is not stored by the component's storage.");
+
+            return std::get<i>(columns);
+        }
+
+    private:
+        std::tuple<std::vector<FieldType<Fields>>...> columns;
+
+        template <auto Field>
+        static constexpr size_t columnIndex()
+        {
+            return fieldIndex<Field, Fields...>();
+        }
+
+        template <typename F>
+        static void swapColumn(std::vector<F> &column, size_t indexA, size_t indexB)
+        {
+            // not std::swap, which does not work on the proxies of a bool column
+            F item = std::move(column[indexA]);
+            column[indexA] = std::move(column[indexB]);
+            column[indexB] = std::move(item);
+        }
+
+        template <typename F>
+        static void swapRemoveColumn(std::vector<F> &column, size_t index)
+        {
+            if (index != column.size() - 1)
+            {
+                column[index] = std::move(column.back());
+            }
+
+            column.pop_back();
+        }
+    };
+}
\ No newline at end of file
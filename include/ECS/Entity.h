@@ -1,8 +1,96 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
+
+/**
+ * The width of entity handles in bits, 32 or 64.
+ *
+ * 32 bit handles have a 24 bit index, which covers ECS_SPARSE_SET_MAX_ID, and an 8 bit generation.
+ * 64 bit handles have a 32 bit index and a 16 bit generation, so a stale handle is only mistaken for a later entity in its slot after 65536 reuses instead of 256.
+ *
+ * Handles are stored in every view, sparse set, scene graph map and AABB tree, so 32 bit handles halve the memory of all of them.
+ *
+ * NOTE: This changes the layout of the engine's types, so it must be the same for the engine and everything built against it.
+ */
+#ifndef ECS_ENTITY_BITS
+#define ECS_ENTITY_BITS 32
+#endif
+
+#if ECS_ENTITY_BITS == 32
+#define ECS_ENTITY_INDEX_BITS 24
+#define ECS_ENTITY_GENERATION_BITS 8
+#elif ECS_ENTITY_BITS == 64
+#define ECS_ENTITY_INDEX_BITS 32
+#define ECS_ENTITY_GENERATION_BITS 16
+#else
+#error "ECS_ENTITY_BITS must be 32 or 64."
+#endif
 
 namespace ECS
 {
+    /**
+     * An entity handle.
+     *
+     * The low ECS_ENTITY_INDEX_BITS bits are the index of the entity's slot in the registry, the next ECS_ENTITY_GENERATION_BITS bits are its generation.
+     * The generation of a slot is incremented every time an entity in it is destroyed, so a handle to a destroyed entity does not refer to a later entity which reuses the slot.
+     *
+     * The first entity in each slot has generation 0, so its handle is equal to its index.
+     */
+#if ECS_ENTITY_BITS == 32
+    using Entity = uint32_t;
+#else
     using Entity = long long unsigned int;
+#endif
+
+    /**
+     * A handle which never refers to an entity.
+     */
+    inline constexpr Entity NULL_ENTITY = ~Entity(0);
+
+    /**
+     * The number of slots which can be addressed by an entity handle.
+     *
+     * The last index is left out, as with 32 bit handles its last generation would be NULL_ENTITY.
+     */
+    inline constexpr size_t MAX_ENTITY_INDICES = (size_t(1) << ECS_ENTITY_INDEX_BITS) - 1;
+
+    /**
+     * Gets the index of an entity's slot.
+     *
+     * @param entity The entity.
+     *
+     * @returns The index of the entity.
+     */
+    constexpr size_t entityIndex(Entity entity)
+    {
+        return entity & ((Entity(1) << ECS_ENTITY_INDEX_BITS) - 1);
+    }
+
+    /**
+     * Gets the generation of an entity.
+     *
+     * @param entity The entity.
+     *
+     * @returns The generation of the entity.
+     */
+    constexpr size_t entityGeneration(Entity entity)
+    {
+        return (entity >> ECS_ENTITY_INDEX_BITS) & ((Entity(1) << ECS_ENTITY_GENERATION_BITS) - 1);
+    }
+
+    /**
+     * Creates an entity handle from a slot index and a generation.
+     *
+     * The generation wraps around to 0 once it no longer fits in ECS_ENTITY_GENERATION_BITS bits.
+     *
+     * @param index The index of the entity's slot.
+     * @param generation The generation of the entity.
+     *
+     * @returns The entity handle.
+     */
+    constexpr Entity makeEntity(size_t index, size_t generation)
+    {
+        return (Entity(generation & ((Entity(1) << ECS_ENTITY_GENERATION_BITS) - 1)) << ECS_ENTITY_INDEX_BITS) | entityIndex(index);
+    }
 }
\ No newline at end of file
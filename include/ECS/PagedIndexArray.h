@@ -0,0 +1,125 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#define ECS_PAGED_INDEX_ARRAY_PAGE_SIZE 4096
+
+namespace ECS
+{
+    /**
+     * A paged array of 32 bit indices.
+     *
+     * The array is split into fixed size pages which are only allocated when an index inside of them is set.
+     * Reading an index from a page which has not been allocated returns NULL_INDEX.
+     *
+     * This is used as the sparse vector of sparse sets so that memory is proportional to the ids actually used,
+     * rather than the maximum id.
+     */
+    class PagedIndexArray
+    {
+    public:
+        /**
+         * The value of an index which has not been set.
+         */
+        static constexpr uint32_t NULL_INDEX = UINT32_MAX;
+
+        /**
+         * Gets the index stored for the given id.
+         *
+         * @param id The id.
+         *
+         * @returns The index or NULL_INDEX if no index has been set for the id.
+         */
+        uint32_t get(size_t id) const
+        {
+            size_t page = id / ECS_PAGED_INDEX_ARRAY_PAGE_SIZE;
+
+            if (page >= pages.size() || pages[page].empty())
+            {
+                return NULL_INDEX;
+            }
+
+            return pages[page][id % ECS_PAGED_INDEX_ARRAY_PAGE_SIZE];
+        }
+
+        /**
+         * Sets the index stored for the given id.
+         *
+         * The page containing the id will be allocated if it does not exist.
+         *
+         * @param id The id.
+         * @param index The index to store.
+         */
+        void set(size_t id, uint32_t index)
+        {
+            size_t page = id / ECS_PAGED_INDEX_ARRAY_PAGE_SIZE;
+
+            if (page >= pages.size())
+            {
+                pages.resize(page + 1);
+            }
+
+            if (pages[page].empty())
+            {
+                pages[page].resize(ECS_PAGED_INDEX_ARRAY_PAGE_SIZE, NULL_INDEX);
+            }
+
+            pages[page][id % ECS_PAGED_INDEX_ARRAY_PAGE_SIZE] = index;
+        }
+
+        /**
+         * Resets the index stored for the given id to NULL_INDEX.
+         *
+         * This will not allocate a page.
+         *
+         * @param id The id.
+         */
+        void reset(size_t id)
+        {
+            size_t page = id / ECS_PAGED_INDEX_ARRAY_PAGE_SIZE;
+
+            if (page >= pages.size() || pages[page].empty())
+            {
+                return;
+            }
+
+            pages[page][id % ECS_PAGED_INDEX_ARRAY_PAGE_SIZE] = NULL_INDEX;
+        }
+
+        /**
+         * Frees all pages.
+         */
+        void clear()
+        {
+            pages.clear();
+        }
+
+        /**
+         * Gets the number of allocated pages.
+         *
+         * @returns The number of allocated pages.
+         */
+        size_t allocatedPages() const
+        {
+            size_t count = 0;
+
+            for (auto &page : pages)
+            {
+                if (!page.empty())
+                {
+                    count++;
+                }
+            }
+
+            return count;
+        }
+
+    private:
+        /**
+         * The pages, unallocated pages are empty.
+         */
+        std::vector<std::vector<uint32_t>> pages;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "CachedView.h"
+
+#include <vector>
+#include <cstdint>
+
+namespace ECS
+{
+    class Registry;
+
+    /**
+     * A handle to a cached view of the entities with a set of components.
+     *
+     * The handle is created by `Registry::persistentView` and resolves the view's cache slot once,
+     * so reading the view through it is a single pointer dereference with no hashing or allocation.
+     *
+     * The handle stays valid for the lifetime of the registry that created it, and always reflects the current state of the view.
+     *
+     * A default constructed handle is invalid and must not be read from.
+     */
+    class PersistentView
+    {
+    public:
+        /**
+         * Creates an invalid persistent view.
+         */
+        PersistentView() = default;
+
+        /**
+         * Creates a persistent view.
+         *
+         * @param registry The registry which owns the view.
+         * @param view The cached view.
+         */
+        PersistentView(const Registry *registry, const CachedView *view) : registry(registry), view(view)
+        {
+        }
+
+        /**
+         * Returns whether or not the handle refers to a view.
+         *
+         * @returns Whether or not the handle is valid.
+         */
+        bool isValid() const
+        {
+            return view != nullptr;
+        }
+
+        /**
+         * Gets the registry which owns the view.
+         *
+         * @returns The registry or nullptr if the handle is invalid.
+         */
+        const Registry *getRegistry() const
+        {
+            return registry;
+        }
+
+        /**
+         * Gets the entities in the view.
+         *
+         * @returns The entities with all of the view's components.
+         */
+        const std::vector<Entity> &getEntities() const
+        {
+            return view->entities;
+        }
+
+        /**
+         * Gets the time the view was last cached.
+         *
+         * See `Registry::viewCachedTime`.
+         *
+         * @returns The time the view was last cached.
+         */
+        uint64_t getCachedTime() const
+        {
+            return view->timestamp;
+        }
+
+        /**
+         * Gets the entities that have been added since the view was last cached.
+         *
+         * See `Registry::viewAddedSinceTimestamp`.
+         *
+         * @returns The entities that have been added since the view was last cached.
+         */
+        const std::vector<Entity> &getAddedSinceTimestamp() const
+        {
+            return view->addedSinceTimestamp;
+        }
+
+        /**
+         * Gets the entities that have been removed since the view was last cached.
+         *
+         * See `Registry::viewRemovedSinceTimestamp`.
+         *
+         * @returns The entities that have been removed since the view was last cached.
+         */
+        const std::vector<Entity> &getRemovedSinceTimestamp() const
+        {
+            return view->removedSinceTimestamp;
+        }
+
+        /**
+         * Gets the number of entities in the view.
+         *
+         * @returns The number of entities in the view.
+         */
+        size_t size() const
+        {
+            return view->entities.size();
+        }
+
+        std::vector<Entity>::const_iterator begin() const
+        {
+            return view->entities.begin();
+        }
+
+        std::vector<Entity>::const_iterator end() const
+        {
+            return view->entities.end();
+        }
+
+    private:
+        const Registry *registry = nullptr;
+        const CachedView *view = nullptr;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,249 @@
+#pragma once
+
+#include "Entity.h"
+#include "Component.h"
+#include "Registry.h"
+
+#include <vector>
+#include <span>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+#include <type_traits>
+
+namespace ECS
+{
+    /**
+     * A prefab is a template for entities, a set of components and child prefabs captured once and instantiated many times.
+     *
+     * Instantiating a prefab with `Registry::instantiate` creates all the copies in one pass, each component pool is reserved once
+     * and the entities are placed straight into their final archetype, so cached views are updated once per entity rather than once per component.
+     *
+     * Child prefabs are instantiated by `World::instantiate`, which relates each copy of a child to its copy of the parent in the scene graph.
+     *
+     * The components are copied into the prefab and copied again into every instance, so they must be copyable.
+     */
+    class Prefab
+    {
+    public:
+        /**
+         * Creates an empty prefab.
+         */
+        Prefab();
+
+        /**
+         * Destroys the prefab and its components.
+         */
+        ~Prefab();
+
+        Prefab(const Prefab &other);
+
+        Prefab &operator=(const Prefab &other);
+
+        /**
+         * Adds a component to the prefab.
+         *
+         * If the prefab already has a component of the type, it will be overwritten.
+         *
+         * The component is copied into every instance, so it must be copy constructible.
+         *
+         * @tparam T The type of component.
+         *
+         * @param component The component to add.
+         *
+         * @returns This prefab, so calls can be chained.
+         */
+        template <typename T>
+        Prefab &add(T component)
+        {
+            static_assert(std::is_copy_constructible_v<T>, "Prefab: A move-only component cannot be added to a prefab, as it is copied into every instance.");
+
+            ComponentId componentId = ComponentIdGenerator::id<T>;
+
+            auto it = findComponent(componentId);
+            if (it != components.end() && (*it)->componentId == componentId)
+            {
+                delete *it;
+                *it = new PrefabComponent<T>(std::move(component));
+            }
+            else
+            {
+                auto index = it - components.begin();
+
+                components.insert(it, new PrefabComponent<T>(std::move(component)));
+                signature.insert(signature.begin() + index, componentId);
+            }
+
+            return *this;
+        }
+
+        /**
+         * Removes a component from the prefab.
+         *
+         * If the prefab does not have the component, nothing will happen.
+         *
+         * @tparam T The type of component.
+         */
+        template <typename T>
+        void remove()
+        {
+            ComponentId componentId = ComponentIdGenerator::id<T>;
+
+            auto it = findComponent(componentId);
+            if (it == components.end() || (*it)->componentId != componentId)
+            {
+                return;
+            }
+
+            signature.erase(signature.begin() + (it - components.begin()));
+
+            delete *it;
+            components.erase(it);
+        }
+
+        /**
+         * Gets a component of the prefab, for modification.
+         *
+         * Changes only affect entities instantiated afterwards.
+         *
+         * @tparam T The type of component.
+         *
+         * @returns A reference to the component.
+         *
+         * @throws std::runtime_error If the prefab does not have the component.
+         */
+        template <typename T>
+        T &get()
+        {
+            ComponentId componentId = ComponentIdGenerator::id<T>;
+
+            auto it = findComponent(componentId);
+            if (it == components.end() || (*it)->componentId != componentId)
+            {
+                throw std::runtime_error("Prefab (get): Prefab does not have component '" + std::string(typeid(T).name()) + "'.");
+            }
+
+            return static_cast<PrefabComponent<T> *>(*it)->component;
+        }
+
+        /**
+         * Returns whether or not the prefab has the given component.
+         *
+         * @tparam T The type of component.
+         *
+         * @returns Whether or not the prefab has the component.
+         */
+        template <typename T>
+        bool has() const
+        {
+            return std::binary_search(signature.begin(), signature.end(), ComponentIdGenerator::id<T>);
+        }
+
+        /**
+         * Adds a child prefab.
+         *
+         * The child is copied, every instance of this prefab gets its own instance of the child.
+         *
+         * @param child The child prefab.
+         *
+         * @returns This prefab, so calls can be chained.
+         */
+        Prefab &addChild(const Prefab &child);
+
+        /**
+         * Gets the child prefabs.
+         *
+         * @returns The child prefabs.
+         */
+        const std::vector<Prefab> &getChildren() const;
+
+        /**
+         * Gets the sorted IDs of the prefab's components.
+         *
+         * @returns The IDs of the components.
+         */
+        const std::vector<ComponentId> &getSignature() const;
+
+    private:
+        friend class Registry;
+
+        /**
+         * A component of the prefab, with its type erased.
+         */
+        class PrefabComponentBase
+        {
+        public:
+            PrefabComponentBase(ComponentId componentId) : componentId(componentId)
+            {
+            }
+
+            virtual ~PrefabComponentBase() = default;
+
+            /**
+             * Copies the component.
+             *
+             * @returns A new copy of the component, owned by the caller.
+             */
+            virtual PrefabComponentBase *clone() const = 0;
+
+            /**
+             * Adds a copy of the component to each of the given entities' component pool.
+             *
+             * Only the pool is updated, not the entities' archetypes or cached views.
+             *
+             * @param registry The registry.
+             * @param entities The entities.
+             */
+            virtual void addTo(Registry &registry, std::span<const Entity> entities) const = 0;
+
+            ComponentId componentId;
+        };
+
+        template <typename T>
+        class PrefabComponent : public PrefabComponentBase
+        {
+        public:
+            PrefabComponent(T component) : PrefabComponentBase(ComponentIdGenerator::id<T>), component(std::move(component))
+            {
+            }
+
+            PrefabComponentBase *clone() const override
+            {
+                return new PrefabComponent<T>(component);
+            }
+
+            void addTo(Registry &registry, std::span<const Entity> entities) const override
+            {
+                registry.addToComponentPool<T>(entities, component);
+            }
+
+            T component;
+        };
+
+        /**
+         * The components, sorted by ID.
+         */
+        std::vector<PrefabComponentBase *> components;
+
+        /**
+         * The IDs of the components, parallel to the components.
+         */
+        std::vector<ComponentId> signature;
+
+        std::vector<Prefab> children;
+
+        /**
+         * Finds the position of the component with the given ID, or where it would be inserted.
+         *
+         * @param componentId The ID of the component.
+         *
+         * @returns An iterator to the position.
+         */
+        std::vector<PrefabComponentBase *>::iterator findComponent(ComponentId componentId);
+
+        /**
+         * Deletes the components.
+         */
+        void clearComponents();
+    };
+}
\ No newline at end of file
@@ -3,8 +3,14 @@
 #include "Entity.h"
 #include "Component.h"
 #include "SparseSet.h"
-#include "../TypeList.h"
+#include "Archetype.h"
+#include "ComponentMask.h"
+#include "CachedView.h"
+#include "PersistentView.h"
+#include "ComponentSignals.h"
 #include "../Core/Timestep.h"
+#include "../Core/JobSystem.h"
+#include "../Core/EventBus.h"
 
 #include <boost/unordered_map.hpp>
 #include <string>
@@ -14,10 +20,19 @@
 #include <vector>
 #include <utility>
 #include <iostream>
-#include <queue>
+#include <tuple>
+#include <span>
+#include <algorithm>
+#include <mutex>
+#include <atomic>
+#include <functional>
+
+#define ECS_REGISTRY_DEFAULT_GRAIN_SIZE 1024
 
 namespace ECS
 {
+    class Prefab;
+
     /**
      * The registry is responsible for creating and managing entities.
      *
@@ -29,7 +44,11 @@ namespace ECS
         /**
          * Creates a new registry.
          *
-         * @param maxEntities The maximum number of entities that can be created.
+         * Entity ids are handed out on demand, so a large maximum costs nothing until the entities are created.
+         *
+         * @param maxEntities The maximum number of entities that can exist at the same time, at most ECS_SPARSE_SET_MAX_ID + 1 as component pools are indexed by entity index.
+         *
+         * @throws std::invalid_argument If maxEntities is 0, or greater than ECS_SPARSE_SET_MAX_ID + 1 or MAX_ENTITY_INDICES.
          */
         Registry(size_t maxEntities);
 
@@ -49,19 +68,92 @@ namespace ECS
          */
         Entity create();
 
+        /**
+         * Creates the given number of entities.
+         *
+         * This is faster than calling `create` in a loop as storage is only reserved once.
+         *
+         * @param count The number of entities to create.
+         *
+         * @returns The new entities.
+         *
+         * @throws std::runtime_error If there are not enough entity ids available.
+         */
+        std::vector<Entity> create(size_t count);
+
+        /**
+         * Creates the given number of copies of a prefab.
+         *
+         * This is much faster than creating the entities and adding their components one by one.
+         * Each component pool is reserved once and the entities are placed straight into the archetype of the prefab,
+         * so cached views are updated once per entity instead of once per component.
+         *
+         * Child prefabs are not instantiated, use `World::instantiate` to instantiate a prefab with its children.
+         *
+         * @param prefab The prefab.
+         * @param count The number of copies to create.
+         * @param init Called with each entity and its index once all entities have been created, e.g. to set a position, can be nullptr.
+         *
+         * @returns The new entities.
+         *
+         * @throws std::runtime_error If there are not enough entity ids available.
+         */
+        std::vector<Entity> instantiate(const Prefab &prefab, size_t count, const std::function<void(Entity, size_t)> &init = nullptr);
+
+        /**
+         * Reserves an entity id without creating the entity.
+         *
+         * The entity does not exist until it is created with `createReserved`, the id must otherwise be given back with `releaseReserved`.
+         *
+         * Unlike `create` this is thread safe, so ids can be handed out while systems run in parallel (see CommandBuffer).
+         *
+         * @returns The reserved entity id.
+         *
+         * @throws std::runtime_error If there are no more entity ids available.
+         */
+        Entity reserve();
+
+        /**
+         * Creates an entity from an id reserved with `reserve`.
+         *
+         * @param entity The reserved entity id.
+         *
+         * @throws std::runtime_error If the entity already exists.
+         */
+        void createReserved(Entity entity);
+
+        /**
+         * Gives an id reserved with `reserve` back without creating the entity.
+         *
+         * @param entity The reserved entity id.
+         *
+         * @throws std::runtime_error If the entity exists.
+         */
+        void releaseReserved(Entity entity);
+
         /**
          * Destroys an entity and all its components.
          *
+         * This is O(1) in the number of entities in the registry.
+         *
          * @param entity The entity to destroy.
          */
         void destroy(Entity entity);
 
         /**
-         * Destroys a vector of entities and all their components.
+         * Destroys a batch of entities and all their components.
+         *
+         * The batch is grouped by archetype, so destroyed signals are published and cached views are checked once per archetype,
+         * and the ids are returned to the free list under a single lock.
+         *
+         * All entities are validated and every destroyed signal is published before any entity is removed,
+         * so if an entity does not exist or a listener throws, no entities are destroyed.
          *
          * @param entities The entities to destroy.
+         *
+         * @throws std::runtime_error If any of the entities do not exist, in which case no entities are destroyed.
          */
-        void destroy(const std::vector<Entity> &entities);
+        void destroy(std::span<const Entity> entities);
 
         /**
          * Destroys all entities and all components.
@@ -71,6 +163,8 @@ namespace ECS
         /**
          * Returns whether or not the registry has the given entity.
          *
+         * This is a single array lookup. A handle to a destroyed entity is never reported as existing, even once its slot has been reused.
+         *
          * @param entity The entity to check.
          *
          * @returns Whether or not the registry has the given entity.
@@ -80,6 +174,10 @@ namespace ECS
         /**
          * Gets all the entities that have the given components.
          *
+         * The view is cached and kept up to date as components are added and removed.
+         *
+         * Each call looks up the view's cache slot, use `persistentView` to avoid the lookup in hot paths.
+         *
          * @tparam Types The types of components.
          *
          * @returns A vector of entities with the given components.
@@ -87,30 +185,23 @@ namespace ECS
         template <typename... Types>
         const std::vector<Entity> &view() const
         {
-            std::set<ComponentId> cacheKey = {ComponentIdGenerator::id<Types>...};
-            // std::set<ComponentId> cacheKey;
-            // getCacheKey(TypeList<Types...>{}, cacheKey);
-
-            if (cachedViews.contains(cacheKey))
-            {
-                // std::cout << "cached" << std::endl;
-                return cachedViews[cacheKey].entities;
-            }
-
-            std::unordered_set<Entity> entitySet;
-            viewHelper<Types...>(TypeList<Types...>{}, entitySet);
-
-            auto cached = cachedViews.insert_or_assign(std::move(cacheKey), CachedView{Core::timeSinceEpochMicrosec(), std::vector<Entity>(entitySet.begin(), entitySet.end())});
-
-            // for (Entity entity : cached.first->second)
-            // {
-            //     if (entity == 101)
-            //     {
-            //         std::cout << "entity: " << entity << std::endl;
-            //     }
-            // }
+            return getCachedView(getViewKey<Types...>()).entities;
+        }
 
-            return cached.first->second.entities;
+        /**
+         * Gets a persistent handle to the view of the given components.
+         *
+         * The view is created and cached if it does not exist yet. The handle resolves the view's cache slot once,
+         * so reading the view through it is a pointer dereference. The handle stays valid for the lifetime of the registry.
+         *
+         * @tparam Types The types of components.
+         *
+         * @returns A handle to the view of the given components.
+         */
+        template <typename... Types>
+        PersistentView persistentView() const
+        {
+            return PersistentView(this, &getCachedView(getViewKey<Types...>()));
         }
 
         /**
@@ -123,14 +214,9 @@ namespace ECS
         template <typename... Types>
         uint64_t viewCachedTime() const
         {
-            std::set<ComponentId> cacheKey = {ComponentIdGenerator::id<Types>...};
-
-            if (cachedViews.contains(cacheKey))
-            {
-                return cachedViews[cacheKey].timestamp;
-            }
+            auto cached = findCachedView(getViewKey<Types...>());
 
-            return 0;
+            return cached != nullptr ? cached->timestamp : 0;
         }
 
         /**
@@ -146,22 +232,193 @@ namespace ECS
         template <typename... Types>
         const std::vector<Entity> &viewAddedSinceTimestamp() const
         {
-            std::set<ComponentId> cacheKey = {ComponentIdGenerator::id<Types>...};
+            auto cached = findCachedView(getViewKey<Types...>());
+
+            return cached != nullptr ? cached->addedSinceTimestamp : emptyEntities;
+        }
+
+        /**
+         * Gets the entities that have been removed since the view of the given components was last cached.
+         *
+         * An entity is removed from a view when it is destroyed or loses one of the view's components.
+         *
+         * An entity which was in the view when it was cached, and has since been removed and added back,
+         * will be in both this and `viewAddedSinceTimestamp`. So removals should be applied before additions.
+         * An entity which was added and then removed again since the view was cached will be in neither.
+         *
+         * @tparam Types The types of components.
+         *
+         * @returns The entities that have been removed since the view of the given components was last cached.
+         */
+        template <typename... Types>
+        const std::vector<Entity> &viewRemovedSinceTimestamp() const
+        {
+            auto cached = findCachedView(getViewKey<Types...>());
+
+            return cached != nullptr ? cached->removedSinceTimestamp : emptyEntities;
+        }
+
+        /**
+         * Calls the given function for every entity that has all the given components, for modification.
+         *
+         * Unlike `view`, this does not build or cache a vector of entities. It iterates the smallest of the component pools
+         * and checks membership in the other pools with a single sparse lookup each, handing the components to the function directly.
+         *
+         * Every component handed to the function is recorded as changed at the current change tick, see `changed`.
+         * Use the const overload, e.g. through `std::as_const`, to only read the components.
+         *
+         * Entities are visited from the back of the smallest pool, so the current entity can safely be destroyed or have its components removed.
+         * Adding components or creating entities during iteration may cause them to be skipped or visited.
+         *
+         * @tparam Types The types of components.
+         *
+         * @param func The function to call, with the signature `void(Entity, Types &...)`. Components with struct of arrays layout are passed as an SoARef.
+         */
+        template <typename... Types, typename Func>
+        void each(Func func)
+        {
+            if (!(hasComponentPool<Types>() && ...))
+            {
+                return;
+            }
+
+            std::tuple<SparseSet<Types> *...> pools{&getComponentPool<Types>()...};
+
+            eachHelper(pools, func, 0, changeTick.load(std::memory_order_relaxed), std::index_sequence_for<Types...>{});
+        }
+
+        /**
+         * Calls the given function for every entity that has all the given components.
+         *
+         * Like the non const `each`, but the components are passed as const references, const SoARefs for components with struct of arrays layout,
+         * and no changes are recorded.
+         *
+         * @tparam Types The types of components.
+         *
+         * @param func The function to call, with the signature `void(Entity, const Types &...)`.
+         */
+        template <typename... Types, typename Func>
+        void each(Func func) const
+        {
+            if (!(hasComponentPool<Types>() && ...))
+            {
+                return;
+            }
+
+            std::tuple<const SparseSet<Types> *...> pools{&getComponentPool<Types>()...};
+
+            eachHelper(pools, func, 0, 0, std::index_sequence_for<Types...>{});
+        }
+
+        /**
+         * Calls the given function for every entity that has all the given components, in parallel, for modification.
+         *
+         * The smallest of the component pools is split into chunks of `grainSize` entities, which are run on the registry's job system.
+         * Every entity is visited by exactly one chunk, so writes to the components handed to the function never race with each other.
+         *
+         * Every component handed to the function is recorded as changed at the current change tick, see `changed`.
+         *
+         * The function is called from multiple threads at the same time, so anything else it touches must be thread safe.
+         *
+         * Structural changes (creating or destroying entities, adding or removing components) are rejected until the loop has finished.
+         *
+         * If the registry has no job system, or there is only a single chunk, this behaves like `each`.
+         *
+         * @tparam Types The types of components.
+         *
+         * @param func The function to call, with the signature `void(Entity, Types &...)`. Components with struct of arrays layout are passed as an SoARef.
+         * @param grainSize The number of entities in each chunk, by default this is ECS_REGISTRY_DEFAULT_GRAIN_SIZE (1024).
+         *
+         * @throws std::invalid_argument If grainSize is 0.
+         * @throws The first exception thrown by the function, once every chunk has finished.
+         */
+        template <typename... Types, typename Func>
+        void parallelEach(Func func, size_t grainSize = ECS_REGISTRY_DEFAULT_GRAIN_SIZE)
+        {
+            if (grainSize == 0)
+            {
+                throw std::invalid_argument("Registry (parallelEach): Grain size must be greater than 0.");
+            }
+
+            if (!(hasComponentPool<Types>() && ...))
+            {
+                return;
+            }
+
+            std::tuple<SparseSet<Types> *...> pools{&getComponentPool<Types>()...};
+
+            eachHelper(pools, func, grainSize, changeTick.load(std::memory_order_relaxed), std::index_sequence_for<Types...>{});
+        }
+
+        /**
+         * Calls the given function for every entity that has all the given components, in parallel.
+         *
+         * Like the non const `parallelEach`, but the components are passed as const references, const SoARefs for components with struct of arrays layout,
+         * and no changes are recorded.
+         *
+         * @tparam Types The types of components.
+         *
+         * @param func The function to call, with the signature `void(Entity, const Types &...)`.
+         * @param grainSize The number of entities in each chunk, by default this is ECS_REGISTRY_DEFAULT_GRAIN_SIZE (1024).
+         *
+         * @throws std::invalid_argument If grainSize is 0.
+         * @throws The first exception thrown by the function, once every chunk has finished.
+         */
+        template <typename... Types, typename Func>
+        void parallelEach(Func func, size_t grainSize = ECS_REGISTRY_DEFAULT_GRAIN_SIZE) const
+        {
+            if (grainSize == 0)
+            {
+                throw std::invalid_argument("Registry (parallelEach): Grain size must be greater than 0.");
+            }
 
-            if (cachedViews.contains(cacheKey))
+            if (!(hasComponentPool<Types>() && ...))
             {
-                return cachedViews[cacheKey].addedSinceTimestamp;
+                return;
             }
 
-            return std::vector<Entity>();
+            std::tuple<const SparseSet<Types> *...> pools{&getComponentPool<Types>()...};
+
+            eachHelper(pools, func, grainSize, 0, std::index_sequence_for<Types...>{});
         }
 
+        /**
+         * Sets the job system used by `parallelEach`.
+         *
+         * The registry does not take ownership of the job system.
+         *
+         * @param jobSystem The job system, or nullptr to run `parallelEach` on the calling thread.
+         */
+        void setJobSystem(Core::JobSystem *jobSystem);
+
+        /**
+         * Gets the job system used by `parallelEach`.
+         *
+         * @returns The job system, or nullptr if there is none.
+         */
+        Core::JobSystem *getJobSystem() const;
+
+        /**
+         * Gets the bus the registry publishes component signals on, see ComponentSignals.h.
+         *
+         * Signals are only built when they have listeners, so subscribing to `ComponentConstructed<T>`, `ComponentUpdated<T>` and `ComponentDestroyed<T>`
+         * lets a system keep its own state up to date incrementally instead of polling the registry.
+         * They are published immediately, listeners cannot create or destroy entities or add or remove components while they run.
+         *
+         * Listeners are allowed to subscribe through a const registry, as subscribing does not change the registry's entities or components.
+         * A listener which may outlive the registry should subscribe to `RegistryDestroyed` and not unsubscribe once it has been published.
+         *
+         * @returns The signal bus.
+         */
+        Core::EventBus &getSignals() const;
+
         /**
          * Adds a component to the given entity.
          *
          * If the component pool does not exist, it will be created.
          *
-         * The component passed in will be copied, so the original component can be destroyed after this function is called.
+         * The component passed in is moved into the pool, so move-only components can be added.
+         * Prefer `emplace` to construct the component in the pool without a temporary.
          *
          * And the reference returned should be used for modifying the component data.
          *
@@ -170,33 +427,67 @@ namespace ECS
          * @param entity The entity to add the component to.
          * @param component The component to add.
          *
-         * @returns A reference to the component.
+         * @returns A reference to the component, an SoARef for components with struct of arrays layout (see ComponentStorage).
          */
         template <typename T>
-        T &add(Entity entity, T component)
+        typename SparseSet<T>::Reference add(Entity entity, T component)
+        {
+            return emplace<T>(entity, std::move(component));
+        }
+
+        /**
+         * Constructs a component in place for the given entity.
+         *
+         * If the component pool does not exist, it will be created.
+         *
+         * A new component is constructed directly in the pool, nothing is copied or moved.
+         * If the entity already has the component, it is replaced by a component constructed from the arguments.
+         *
+         * @tparam T The type of component.
+         * @tparam Args The types of the constructor arguments.
+         *
+         * @param entity The entity to add the component to.
+         * @param args The arguments to construct the component with.
+         *
+         * @returns A reference to the component, an SoARef for components with struct of arrays layout (see ComponentStorage).
+         */
+        template <typename T, typename... Args>
+        typename SparseSet<T>::Reference emplace(Entity entity, Args &&...args)
         {
             if (!has(entity))
             {
-                throw std::runtime_error("Registry (add): Entity '" + std::to_string(entity) + "' does not exist.");
+                throw std::runtime_error("Registry (emplace): Entity '" + std::to_string(entity) + "' does not exist.");
             }
 
-            // std::cout << "adding to " << entity << std::endl;
-            // std::cout << "type name: " << typeid(T).name() << ", type id: " << ComponentIdGenerator::id<T> << std::endl;
-
             if (!hasComponentPool<T>())
             {
+                checkStructuralChange("emplace");
                 createComponentPool<T>();
             }
 
             auto &componentPool = getComponentPool<T>();
             bool hasEntity = componentPool.has(entity);
 
-            componentPool.add(entity, component);
+            // overwriting an existing component is not a structural change
+            if (!hasEntity)
+            {
+                checkStructuralChange("emplace");
+            }
+
+            componentPool.emplace(entity, changeTick.load(std::memory_order_relaxed), std::forward<Args>(args)...);
 
-            // only update cached views if the entity didn't already have the component
+            // only move the entity and update cached views if the entity didn't already have the component
             if (!hasEntity)
             {
+                moveArchetype(entity, ComponentIdGenerator::id<T>, true);
                 updateCachedViews<T>(entity);
+                addToGroups(ComponentIdGenerator::id<T>, entity);
+
+                publishSignal<ComponentConstructed<T>>(entity);
+            }
+            else
+            {
+                publishSignal<ComponentUpdated<T>>(entity);
             }
 
             return componentPool.get(entity);
@@ -230,164 +521,1202 @@ namespace ECS
                 return;
             }
 
+            checkStructuralChange("remove");
+
+            publishSignal<ComponentDestroyed<T>>(entity);
+
+            removeFromGroups(ComponentIdGenerator::id<T>, entity);
             componentPool.remove(entity);
-            invalidateCachedViews<T>();
+            moveArchetype(entity, ComponentIdGenerator::id<T>, false);
+            removeFromCachedViews<T>(entity);
         }
 
         /**
-         * Gets the component for the given entity.
+         * Gets the component for the given entity, for modification.
+         *
+         * The component is recorded as changed at the current change tick, see `changed`.
+         *
+         * The entity and component are only validated when ECS_CHECKED_ACCESS is enabled (see SparseSet.h), which by default it is not in NDEBUG builds.
+         * Use `tryGet` when the entity may not have the component.
          *
          * @tparam T The type of component.
          *
          * @param entity The entity to get the component for.
          *
-         * @returns A reference to the component.
+         * @returns A reference to the component, an SoARef for components with struct of arrays layout (see ComponentStorage).
+         *
+         * @throws std::runtime_error If the entity does not have the component and ECS_CHECKED_ACCESS is enabled.
          */
         template <typename T>
-        T &get(Entity entity) const
+        typename SparseSet<T>::Reference get(Entity entity)
         {
+#if ECS_CHECKED_ACCESS
             if (!has<T>(entity))
             {
                 throw std::runtime_error("Registry (get): Entity '" + std::to_string(entity) + "' does not have component '" + typeid(T).name() + "'.");
             }
+#endif
 
-            return getComponentPool<T>().get(entity);
+            return getUnchecked<T>(entity);
         }
 
         /**
-         * Returns whether or not the given entity has the given component.
+         * Gets the component for the given entity.
+         *
+         * This does not record a change.
+         *
+         * The entity and component are only validated when ECS_CHECKED_ACCESS is enabled (see SparseSet.h), which by default it is not in NDEBUG builds.
+         * Use `tryGet` when the entity may not have the component.
          *
          * @tparam T The type of component.
          *
-         * @param entity The entity to check.
+         * @param entity The entity to get the component for.
          *
-         * @returns Whether or not the entity has the component.
+         * @returns A const reference to the component, a const SoARef for components with struct of arrays layout (see ComponentStorage).
+         *
+         * @throws std::runtime_error If the entity does not have the component and ECS_CHECKED_ACCESS is enabled.
          */
         template <typename T>
-        bool has(Entity entity) const
+        typename SparseSet<T>::ConstReference get(Entity entity) const
         {
-            if (!has(entity))
-            {
-                return false;
-            }
-
-            if (!hasComponentPool<T>())
+#if ECS_CHECKED_ACCESS
+            if (!has<T>(entity))
             {
-                return false;
+                throw std::runtime_error("Registry (get): Entity '" + std::to_string(entity) + "' does not have component '" + typeid(T).name() + "'.");
             }
+#endif
 
-            SparseSet<T> &componentPool = getComponentPool<T>();
-            return componentPool.has(entity);
+            return getUnchecked<T>(entity);
         }
 
         /**
-         * Gets all entities.
+         * Gets the component for the given entity, for modification, without validating the entity or component.
          *
-         * @returns A reference to the vector of all entities.
-         */
-        const std::vector<Entity> &getEntities() const;
-
-        /**
-         * Gets the size of the registry.
+         * The component is recorded as changed at the current change tick, see `changed`.
          *
-         * This is the number of entities in the registry.
+         * The entity must exist and have the component, otherwise the behaviour is undefined.
+         * This is what `get` compiles to when ECS_CHECKED_ACCESS is disabled.
          *
-         * @returns The size of the registry.
-         */
-        size_t size() const;
-
-    private:
-        /**
-         * The maximum number of entities that can be created.
-         */
-        size_t maxEntities;
-
-        std::queue<Entity> freeEntityIds;
-
-        /**
-         * The entities in the registry.
-         */
-        std::vector<Entity> entities;
-
-        /**
-         * The entities in the registry as a set.
-         */
-        std::unordered_set<Entity> entitiesSet;
-
-        /**
-         * The threshold for when to invalidate the cached entity views instead of adding to `addedSinceTimestamp`.
-         */
-        size_t cacheUpdateInvalidationThreshold = 2500;
-
-        /**
-         * The component pools.
+         * @tparam T The type of component.
          *
-         * These store sparse sets of components for each component type.
-         */
-        mutable std::unordered_map<ComponentId, SparseSetBase *> componentPools;
-
-        /**
-         * A cached view of entities with a set of components.
+         * @param entity The entity to get the component for.
          *
-         * @param timestamp The timestamp of the cache.
-         * @param entities The entities in the cache.
-         * @param addedSinceTimestamp The entities that have been added since the timestamp. These are entities added by `updateCachedViews`.
+         * @returns A reference to the component, an SoARef for components with struct of arrays layout (see ComponentStorage).
          */
-        struct CachedView
+        template <typename T>
+        typename SparseSet<T>::Reference getUnchecked(Entity entity)
         {
-            uint64_t timestamp;
-            std::vector<Entity> entities;
-            std::vector<Entity> addedSinceTimestamp;
-        };
+            return getComponentPoolUnchecked<T>().getChangedUnchecked(entity, changeTick.load(std::memory_order_relaxed));
+        }
 
         /**
-         * The cached entity views.
+         * Gets the component for the given entity without validating the entity or component.
          *
-         * The key is a set of component IDs.
+         * This does not record a change.
          *
-         * The value is a vector of entities that have all the components in the key.
-         */
-        mutable boost::unordered_map<std::set<ComponentId>, CachedView> cachedViews;
-
-        /**
-         * Invalidates the cached entity views for the given component.
+         * The entity must exist and have the component, otherwise the behaviour is undefined.
+         * This is what `get` compiles to when ECS_CHECKED_ACCESS is disabled.
          *
          * @tparam T The type of component.
+         *
+         * @param entity The entity to get the component for.
+         *
+         * @returns A const reference to the component, a const SoARef for components with struct of arrays layout (see ComponentStorage).
          */
         template <typename T>
-        void invalidateCachedViews()
+        typename SparseSet<T>::ConstReference getUnchecked(Entity entity) const
         {
-            auto componentId = ComponentIdGenerator::id<T>;
-
-            invalidateCachedViews(componentId);
+            return std::as_const(getComponentPoolUnchecked<T>()).getUnchecked(entity);
         }
 
         /**
-         * Invalidates the cached entity views for the given component.
+         * Gets the component for the given entity, for modification, if it has one.
          *
-         * @param componentId The ID of the component.
-         */
-        void invalidateCachedViews(ComponentId componentId)
-        {
-            auto it = cachedViews.begin();
-
-            while (it != cachedViews.end())
-            {
-                auto &[components, view] = *it;
-
-                if (components.contains(componentId))
-                {
-                    // erase and update iterator to next element
-                    it = cachedViews.erase(it);
+         * The component is recorded as changed at the current change tick, see `changed`.
+         *
+         * This never throws and costs a single sparse lookup, so it should replace `has` followed by `get`.
+         *
+         * Only available for array of structs layout, use `has` and `get` otherwise.
+         *
+         * @tparam T The type of component.
+         *
+         * @param entity The entity to get the component for.
+         *
+         * @returns A pointer to the component, or nullptr if the entity does not exist or does not have the component.
+         */
+        template <typename T>
+            requires(!isSoAComponent<T>)
+        T *tryGet(Entity entity)
+        {
+            if (!hasComponentPool<T>())
+            {
+                return nullptr;
+            }
+
+            // the pool compares the whole handle, so a destroyed entity is never found
+            return getComponentPoolUnchecked<T>().tryGetChanged(entity, changeTick.load(std::memory_order_relaxed));
+        }
+
+        /**
+         * Gets the component for the given entity, if it has one.
+         *
+         * This does not record a change.
+         *
+         * This never throws and costs a single sparse lookup, so it should replace `has` followed by `get`.
+         *
+         * Only available for array of structs layout, use `has` and `get` otherwise.
+         *
+         * @tparam T The type of component.
+         *
+         * @param entity The entity to get the component for.
+         *
+         * @returns A pointer to the component, or nullptr if the entity does not exist or does not have the component.
+         */
+        template <typename T>
+            requires(!isSoAComponent<T>)
+        const T *tryGet(Entity entity) const
+        {
+            if (!hasComponentPool<T>())
+            {
+                return nullptr;
+            }
+
+            return getComponentPoolUnchecked<T>().tryGet(entity);
+        }
+
+        /**
+         * Records the given entity's component as changed at the current change tick.
+         *
+         * Writes made through a reference kept from an earlier `get`, or through `getUnchecked` const, are not tracked,
+         * so this should be called for them if they need to show up in `changed`.
+         *
+         * If the entity does not have the component, nothing will happen.
+         *
+         * This only updates change tracking and not the component itself, so it can be called on a const registry.
+         *
+         * @tparam T The type of component.
+         *
+         * @param entity The entity whose component changed.
+         */
+        template <typename T>
+        void markChanged(Entity entity) const
+        {
+            if (!has(entity) || !hasComponentPool<T>())
+            {
+                return;
+            }
+
+            getComponentPool<T>().setChangeTick(entity, changeTick.load(std::memory_order_relaxed));
+        }
+
+        /**
+         * Gets the entities whose component of the given type has changed since the given tick.
+         *
+         * A component is changed when it is added or accessed through the non-const `get`.
+         *
+         * A typical consumer advances the tick and then asks for the changes since the tick it advanced last time:
+         *
+         * ```
+         * uint64_t tick = registry.advanceChangeTick();
+         * auto entities = registry.changed<Core::Transform>(lastTick);
+         * lastTick = tick;
+         * ```
+         *
+         * This is a linear scan over the ticks of the component pool, which is much cheaper than visiting the components themselves.
+         *
+         * @tparam T The type of component.
+         *
+         * @param sinceTick The tick to get changes after, changes made at this tick are not included.
+         *
+         * @returns The entities whose component has changed.
+         */
+        template <typename T>
+        std::vector<Entity> changed(uint64_t sinceTick) const
+        {
+            std::vector<Entity> entities;
+
+            if (!hasComponentPool<T>())
+            {
+                return entities;
+            }
+
+            auto &componentPool = getComponentPool<T>();
+            auto &ticks = componentPool.getChangeTicks();
+            auto &ids = componentPool.getDenseIds();
+
+            for (size_t i = 0; i < ticks.size(); i++)
+            {
+                if (ticks[i] > sinceTick)
+                {
+                    entities.push_back(ids[i]);
+                }
+            }
+
+            return entities;
+        }
+
+        /**
+         * Returns whether or not the given entity's component has changed since the given tick.
+         *
+         * @tparam T The type of component.
+         *
+         * @param entity The entity to check.
+         * @param sinceTick The tick to check for changes after.
+         *
+         * @returns Whether or not the component has changed, false if the entity does not have the component.
+         */
+        template <typename T>
+        bool hasChanged(Entity entity, uint64_t sinceTick) const
+        {
+            if (!has<T>(entity))
+            {
+                return false;
+            }
+
+            return getComponentPool<T>().getChangeTick(entity) > sinceTick;
+        }
+
+        /**
+         * Gets the current change tick.
+         *
+         * Changes are recorded at this tick until it is advanced.
+         *
+         * @returns The current change tick.
+         */
+        uint64_t getChangeTick() const;
+
+        /**
+         * Advances the change tick.
+         *
+         * Changes made after this call are recorded at a later tick than the one returned,
+         * so they will be included in `changed` for the returned tick.
+         *
+         * @returns The change tick before it was advanced.
+         */
+        uint64_t advanceChangeTick() const;
+
+        /**
+         * Returns whether or not the given entity has all the given components.
+         *
+         * This checks the component mask of the entity's archetype, the component pools are not touched.
+         *
+         * @tparam T The type of component.
+         * @tparam Rest The types of any other components.
+         *
+         * @param entity The entity to check.
+         *
+         * @returns Whether or not the entity has the components.
+         */
+        template <typename T, typename... Rest>
+        bool has(Entity entity) const
+        {
+            if (!has(entity))
+            {
+                return false;
+            }
+
+            auto archetype = getLocation(entity).archetype;
+
+            if constexpr (sizeof...(Rest) == 0)
+            {
+                return archetype->has(ComponentIdGenerator::id<T>);
+            }
+            else
+            {
+                return archetype->hasAll(getViewMask<T, Rest...>());
+            }
+        }
+
+        /**
+         * Gets the number of entities with the given component.
+         *
+         * @tparam T The type of component.
+         *
+         * @returns The number of components of the type.
+         */
+        template <typename T>
+        size_t count() const
+        {
+            if (!hasComponentPool<T>())
+            {
+                return 0;
+            }
+
+            return getComponentPool<T>().size();
+        }
+
+        /**
+         * Sorts the component pool of the given type, so the components are stored in sorted order.
+         *
+         * `each` walks a pool from the back, so it visits the components in reverse order, `eachGroup` visits a group in sorted order.
+         *
+         * If the component is owned by a group, the entities in the group are sorted together at the front of every owned pool,
+         * followed by the rest of the pool sorted on its own.
+         *
+         * Sorting moves components in the pool, so references to them are invalidated.
+         *
+         * @tparam T The type of component.
+         * @tparam Compare The comparator, `bool(a, b)` returning whether a goes before b, taking `const T &` or `SoARef<T, true>` for struct of arrays layout.
+         *
+         * @param compare The comparator.
+         */
+        template <typename T, typename Compare>
+        void sort(Compare compare)
+        {
+            if (!hasComponentPool<T>())
+            {
+                return;
+            }
+
+            checkStructuralChange("sort");
+
+            auto &componentPool = getComponentPool<T>();
+
+            auto group = getOwningGroup(ComponentIdGenerator::id<T>);
+            if (group == nullptr)
+            {
+                componentPool.sort(compare);
+                return;
+            }
+
+            componentPool.sort(0, group->size, compare);
+            componentPool.sort(group->size, componentPool.size(), compare);
+
+            // the other owned pools follow the sorted pool's order
+            auto ids = componentPool.getDenseIds().data();
+
+            for (auto componentId : group->componentIds)
+            {
+                if (componentId != ComponentIdGenerator::id<T>)
+                {
+                    arrangeComponentPool(componentId, ids, group->size);
+                }
+            }
+        }
+
+        /**
+         * Creates a group owning the component pools of the given types.
+         *
+         * The entities which have all the components are kept packed at the front of each owned pool, in the same order in every pool.
+         * So the components of the group can be iterated in lockstep with `eachGroup`, without any sparse lookups.
+         *
+         * Keeping the group packed moves components when a component of the group is added or removed,
+         * so references to owned components are invalidated by adding or removing any owned component, not just one of the same type.
+         *
+         * A component can only be owned by one group. Creating a group which already exists does nothing.
+         *
+         * @tparam Owned The types of components, at least two.
+         *
+         * @throws std::runtime_error If a component is already owned by a different group.
+         */
+        template <typename... Owned>
+        void group()
+        {
+            static_assert(sizeof...(Owned) > 1, "Registry (group): A group must own at least two components.");
+
+            auto &componentIds = getViewKey<Owned...>();
+
+            if (findGroup(componentIds) != nullptr)
+            {
+                return;
+            }
+
+            checkStructuralChange("group");
+
+            for (auto componentId : componentIds)
+            {
+                if (getOwningGroup(componentId) != nullptr)
+                {
+                    throw std::runtime_error("Registry (group): Component '" + std::to_string(componentId) + "' is already owned by another group.");
+                }
+            }
+
+            ((hasComponentPool<Owned>() || (createComponentPool<Owned>(), true)), ...);
+
+            createGroup(componentIds);
+        }
+
+        /**
+         * Returns whether or not a group owning exactly the given components exists.
+         *
+         * @tparam Owned The types of components.
+         *
+         * @returns Whether or not the group exists.
+         */
+        template <typename... Owned>
+        bool hasGroup() const
+        {
+            return findGroup(getViewKey<Owned...>()) != nullptr;
+        }
+
+        /**
+         * Gets the number of entities in the group owning the given components.
+         *
+         * These are the first entities of each owned pool.
+         *
+         * @tparam Owned The types of components.
+         *
+         * @returns The number of entities in the group.
+         *
+         * @throws std::runtime_error If the group does not exist.
+         */
+        template <typename... Owned>
+        size_t groupSize() const
+        {
+            return getGroup(getViewKey<Owned...>()).size;
+        }
+
+        /**
+         * Iterates the entities in the group owning the given components, for modification.
+         *
+         * The owned pools are walked in lockstep, the components of an entity are at the same index of every pool.
+         *
+         * Like `each`, components must not be added or removed during iteration,
+         * and every component handed to the function is recorded as changed at the current change tick.
+         *
+         * @tparam Owned The types of components.
+         * @tparam Func The function type, `void(Entity, T &...)` taking the components in the order of Owned.
+         *
+         * @param func The function to call for each entity.
+         *
+         * @throws std::runtime_error If the group does not exist.
+         */
+        template <typename... Owned, typename Func>
+        void eachGroup(Func func)
+        {
+            size_t size = getGroup(getViewKey<Owned...>()).size;
+
+            if (size == 0)
+            {
+                return;
+            }
+
+            std::tuple<SparseSet<Owned> *...> pools{&getComponentPool<Owned>()...};
+
+            eachGroupHelper(size, pools, func, changeTick.load(std::memory_order_relaxed));
+        }
+
+        /**
+         * Iterates the entities in the group owning the given components.
+         *
+         * Like the non const `eachGroup`, but the components are passed as const references and no changes are recorded.
+         *
+         * @tparam Owned The types of components.
+         * @tparam Func The function type, `void(Entity, const T &...)` taking the components in the order of Owned.
+         *
+         * @param func The function to call for each entity.
+         *
+         * @throws std::runtime_error If the group does not exist.
+         */
+        template <typename... Owned, typename Func>
+        void eachGroup(Func func) const
+        {
+            size_t size = getGroup(getViewKey<Owned...>()).size;
+
+            if (size == 0)
+            {
+                return;
+            }
+
+            std::tuple<const SparseSet<Owned> *...> pools{&getComponentPool<Owned>()...};
+
+            eachGroupHelper(size, pools, func, 0);
+        }
+
+        /**
+         * Writes the entities and the given components to a snapshot.
+         *
+         * Components of other types are not written, entities are written without them.
+         *
+         * @tparam Types The types of components to write, must be trivially copyable.
+         *
+         * @param writer The snapshot writer.
+         *
+         * @throws std::runtime_error If the stream fails.
+         */
+        template <typename... Types>
+        void writeSnapshot(SnapshotWriter &writer) const
+        {
+            static_assert((std::is_trivially_copyable_v<Types> && ...), "Registry (writeSnapshot): Only trivially copyable components can be written to a snapshot.");
+
+            auto components = getSnapshotComponents<Types...>("writeSnapshot");
+
+            writeSnapshotEntities(writer, components);
+
+            uint64_t poolCount = (static_cast<uint64_t>(hasComponentPool<Types>()) + ... + 0);
+            writer.write<uint64_t>(poolCount);
+
+            (writeSnapshotPool<Types>(writer), ...);
+        }
+
+        /**
+         * Replaces the contents of the registry with a snapshot written by `writeSnapshot`.
+         *
+         * All entities are destroyed first. The entities keep the ids they were written with
+         * and each component pool is filled in bulk, with a single copy for components stored as an array of structs.
+         * Cached views are rebuilt once at the end rather than updated per entity.
+         *
+         * Every loaded component is recorded as changed at the current change tick.
+         *
+         * Entity ids reserved with `reserve` are invalidated, so this must not be called while they are outstanding.
+         *
+         * @tparam Types The types of components in the snapshot, must be trivially copyable and the same size as when written.
+         *
+         * @param reader The snapshot reader.
+         *
+         * @throws std::runtime_error If the snapshot is invalid or has components not in Types, the registry is then left empty.
+         * @throws std::invalid_argument If the component types are not unique.
+         */
+        template <typename... Types>
+        void readSnapshot(SnapshotReader &reader)
+        {
+            static_assert((std::is_trivially_copyable_v<Types> && ...), "Registry (readSnapshot): Only trivially copyable components can be read from a snapshot.");
+
+            auto components = getSnapshotComponents<Types...>("readSnapshot");
+
+            destroyAll();
+
+            try
+            {
+                readSnapshotEntities(reader, components);
+
+                auto poolCount = reader.read<uint64_t>();
+
+                for (uint64_t i = 0; i < poolCount; i++)
+                {
+                    auto componentHash = reader.read<uint64_t>();
+
+                    bool found = ((componentHash == ComponentIdGenerator::hash<Types> && (readSnapshotPool<Types>(reader), true)) || ...);
+                    if (!found)
+                    {
+                        throw std::runtime_error("Registry (readSnapshot): Snapshot has component '" + std::to_string(componentHash) + "' which is not one of the given component types.");
+                    }
+                }
+
+                finishSnapshot();
+            }
+            catch (...)
+            {
+                clearEntities();
+                throw;
+            }
+
+            for (auto archetype : archetypes)
+            {
+                publishConstructedSignals(*archetype, archetype->getEntities());
+            }
+        }
+
+        /**
+         * Gets all entities.
+         *
+         * @returns A reference to the vector of all entities.
+         */
+        const std::vector<Entity> &getEntities() const;
+
+        /**
+         * Gets the size of the registry.
+         *
+         * This is the number of entities in the registry.
+         *
+         * @returns The size of the registry.
+         */
+        size_t size() const;
+
+    private:
+        friend class Prefab;
+
+        /**
+         * The maximum number of entities that can be created.
+         */
+        size_t maxEntities;
+
+        /**
+         * The handles of destroyed entities with their slot's next generation, reused before new slots are used.
+         */
+        std::vector<Entity> freeEntityIds;
+
+        /**
+         * The index of the next slot which has never been handed out, slots from here to maxEntities are implicitly free.
+         */
+        size_t nextEntityIndex = 0;
+
+        /**
+         * Guards the free entity ids, so ids can be reserved from any thread.
+         */
+        std::mutex freeEntityIdsMutex;
+
+        /**
+         * The entities in the registry.
+         */
+        std::vector<Entity> entities;
+
+        /**
+         * The location of an entity in the registry's storage.
+         *
+         * The indices are 32 bit as there are fewer than MAX_ENTITY_INDICES entities, so with 32 bit handles a location is 24 bytes.
+         *
+         * @param archetype The archetype the entity belongs to.
+         * @param entity The handle of the entity in the slot, or NULL_ENTITY if the slot is free.
+         * @param index The index of the entity in the entities vector.
+         * @param row The row of the entity in the archetype.
+         */
+        struct EntityLocation
+        {
+            Archetype *archetype = nullptr;
+            Entity entity = NULL_ENTITY;
+            uint32_t index = 0;
+            uint32_t row = 0;
+        };
+
+        /**
+         * A group owning the component pools of its components, see `group`.
+         *
+         * @param componentIds The sorted IDs of the owned components.
+         * @param mask The owned components as a mask.
+         * @param size The number of entities in the group, these are the first entities of each owned pool.
+         */
+        struct Group
+        {
+            std::vector<ComponentId> componentIds;
+            ComponentMask mask;
+            size_t size = 0;
+        };
+
+        /**
+         * The location of each entity in the entities vector and archetype tables, indexed by the entity's slot index.
+         */
+        std::vector<EntityLocation> entityLocations;
+
+        /**
+         * Gets the number of entity ids which can still be handed out.
+         *
+         * The free entity ids mutex must be held.
+         *
+         * @returns The number of available entity ids.
+         */
+        size_t availableEntityIds() const;
+
+        /**
+         * Takes an entity id, reusing a destroyed entity's slot before a new one.
+         *
+         * The free entity ids mutex must be held and an id must be available.
+         *
+         * @returns The entity id.
+         */
+        Entity takeEntityId();
+
+        /**
+         * Gets the location of an entity.
+         *
+         * @param entity The entity, which must exist.
+         *
+         * @returns The location of the entity.
+         */
+        EntityLocation &getLocation(Entity entity)
+        {
+            return entityLocations[entityIndex(entity)];
+        }
+
+        const EntityLocation &getLocation(Entity entity) const
+        {
+            return entityLocations[entityIndex(entity)];
+        }
+
+        /**
+         * The archetype tables.
+         *
+         * Every entity in the registry belongs to exactly one archetype, entities without components belong to the empty archetype.
+         */
+        std::vector<Archetype *> archetypes;
+
+        /**
+         * The archetype tables by signature.
+         */
+        boost::unordered_map<std::vector<ComponentId>, Archetype *> archetypesBySignature;
+
+        /**
+         * The archetype of entities with no components.
+         */
+        Archetype *emptyArchetype;
+
+        /**
+         * Adds an entity id to the entities vector and the empty archetype.
+         *
+         * @param entity The entity.
+         */
+        void addEntity(Entity entity);
+
+        /**
+         * Removes an entity and its components from its archetype and any cached views, and returns its id to the free list.
+         *
+         * @param entity The entity.
+         */
+        void removeEntity(Entity entity);
+
+        /**
+         * Removes an entity and its components from the entities vector, its archetype, the component pools and groups.
+         *
+         * No signals are published, cached views are not updated and the entity's id is not returned to the free list.
+         *
+         * @param entity The entity.
+         */
+        void eraseEntity(Entity entity);
+
+        /**
+         * Gets the archetype with the given signature.
+         *
+         * If the archetype does not exist, it will be created.
+         *
+         * @param signature The sorted component ids of the archetype.
+         *
+         * @returns The archetype.
+         */
+        Archetype *getArchetype(const std::vector<ComponentId> &signature);
+
+        /**
+         * Moves the entity into the given archetype.
+         *
+         * @param entity The entity to move.
+         * @param archetype The archetype to move the entity to, if this is nullptr the entity will only be removed from its current archetype.
+         */
+        void setArchetype(Entity entity, Archetype *archetype);
+
+        /**
+         * Moves the entity to the archetype it belongs to after the given component has been added or removed.
+         *
+         * @param entity The entity to move.
+         * @param componentId The ID of the component that was added or removed.
+         * @param added Whether the component was added or removed.
+         */
+        void moveArchetype(Entity entity, ComponentId componentId, bool added);
+
+        /**
+         * Collects the entities of every archetype which contains all the given components.
+         *
+         * @param componentMask The mask of the components.
+         *
+         * @returns The entities with all the components.
+         */
+        std::vector<Entity> collectArchetypeEntities(const ComponentMask &componentMask) const;
+
+        /**
+         * Removes all entities, component pools and archetype rows without returning the entity ids to the free list.
+         *
+         * Cached views are rebuilt.
+         */
+        void clearEntities();
+
+        /**
+         * The components of a snapshot, the hash which identifies each component in the snapshot paired with its ID, sorted by hash.
+         */
+        using SnapshotComponents = std::vector<std::pair<uint64_t, ComponentId>>;
+
+        /**
+         * Gets the components of a snapshot.
+         *
+         * Component IDs depend on the order components are first used, so snapshots identify components by the hash of their type instead.
+         *
+         * @tparam Types The types of components in the snapshot.
+         *
+         * @param method The name of the method writing or reading the snapshot.
+         *
+         * @returns The components.
+         *
+         * @throws std::invalid_argument If two of the components are the same or have the same hash.
+         */
+        template <typename... Types>
+        static SnapshotComponents getSnapshotComponents(const char *method)
+        {
+            SnapshotComponents components{{ComponentIdGenerator::hash<Types>, ComponentIdGenerator::id<Types>}...};
+
+            std::sort(components.begin(), components.end());
+
+            if (std::adjacent_find(components.begin(), components.end(), [](const auto &a, const auto &b)
+                                   { return a.first == b.first; }) != components.end())
+            {
+                throw std::invalid_argument("Registry (" + std::string(method) + "): Component types must be unique.");
+            }
+
+            return components;
+        }
+
+        /**
+         * Writes the entities and the archetype tables to a snapshot.
+         *
+         * Archetype signatures are written as component hashes, without the components which are not written.
+         *
+         * @param writer The snapshot writer.
+         * @param components The components which are written.
+         */
+        void writeSnapshotEntities(SnapshotWriter &writer, const SnapshotComponents &components) const;
+
+        /**
+         * Reads the entities and the archetype tables from a snapshot into the empty registry.
+         *
+         * @param reader The snapshot reader.
+         * @param components The components which can be read.
+         *
+         * @throws std::runtime_error If the snapshot is truncated, or has invalid entities, archetypes or components.
+         */
+        void readSnapshotEntities(SnapshotReader &reader, const SnapshotComponents &components);
+
+        /**
+         * Checks the component pools read from a snapshot against the archetypes, then rebuilds the free list and cached views.
+         *
+         * @throws std::runtime_error If an archetype has a component with no pool.
+         */
+        void finishSnapshot();
+
+        /**
+         * Creates a group owning the given components and packs the entities which have all of them.
+         *
+         * @param componentIds The sorted IDs of the components, which must all have pools and not be owned.
+         */
+        void createGroup(const std::vector<ComponentId> &componentIds);
+
+        /**
+         * Finds the group owning exactly the given components.
+         *
+         * @param componentIds The sorted IDs of the components.
+         *
+         * @returns The group or nullptr if it does not exist.
+         */
+        Group *findGroup(const std::vector<ComponentId> &componentIds) const;
+
+        /**
+         * Gets the group owning exactly the given components.
+         *
+         * @param componentIds The sorted IDs of the components.
+         *
+         * @returns The group.
+         *
+         * @throws std::runtime_error If the group does not exist.
+         */
+        const Group &getGroup(const std::vector<ComponentId> &componentIds) const;
+
+        /**
+         * Empties the group and packs every entity which has all its components.
+         *
+         * @param group The group.
+         */
+        void buildGroup(Group &group);
+
+        /**
+         * Moves an entity to the back of the group in every owned pool.
+         *
+         * @param group The group.
+         * @param entity The entity, which must have all the components and not be in the group.
+         */
+        void addToGroup(Group &group, Entity entity);
+
+        /**
+         * Moves an entity just past the end of the group in every owned pool.
+         *
+         * @param group The group.
+         * @param entity The entity, which must be in the group.
+         */
+        void removeFromGroup(Group &group, Entity entity);
+
+        /**
+         * Adds the entity to the group owning the given component, if there is one and the entity now has all its components.
+         *
+         * @param componentId The ID of the component which was added.
+         * @param entity The entity.
+         */
+        void addToGroups(ComponentId componentId, Entity entity);
+
+        /**
+         * Removes the entity from the group owning the given component, if there is one and the entity is in it.
+         *
+         * @param componentId The ID of the component which is about to be removed.
+         * @param entity The entity.
+         */
+        void removeFromGroups(ComponentId componentId, Entity entity);
+
+        /**
+         * Moves the components of the given entities to the front of a component pool, in the same order.
+         *
+         * @param componentId The ID of the component.
+         * @param ids The entities, which must all have the component.
+         * @param count The number of entities.
+         */
+        void arrangeComponentPool(ComponentId componentId, const Entity *ids, size_t count);
+
+        /**
+         * Adds a copy of the component to each of the given entities' component pool, creating the pool if it does not exist.
+         *
+         * Only the pool is updated, the caller must update the entities' archetypes and the cached views.
+         *
+         * @tparam T The type of component.
+         *
+         * @param entities The entities, which must not already have the component.
+         * @param component The component to add.
+         */
+        template <typename T>
+        void addToComponentPool(std::span<const Entity> entities, const T &component)
+        {
+            auto &componentPool = hasComponentPool<T>() ? getComponentPool<T>() : createComponentPool<T>();
+            componentPool.reserve(componentPool.size() + entities.size());
+
+            auto tick = changeTick.load(std::memory_order_relaxed);
+
+            for (auto entity : entities)
+            {
+                componentPool.add(entity, component, tick);
+            }
+        }
+
+        /**
+         * Writes the component pool for the given component type to a snapshot, if it exists.
+         *
+         * @tparam T The type of component.
+         *
+         * @param writer The snapshot writer.
+         */
+        template <typename T>
+        void writeSnapshotPool(SnapshotWriter &writer) const
+        {
+            if (!hasComponentPool<T>())
+            {
+                return;
+            }
+
+            writer.write<uint64_t>(ComponentIdGenerator::hash<T>);
+            writer.write<uint64_t>(sizeof(T));
+
+            getComponentPool<T>().writeSnapshot(writer);
+        }
+
+        /**
+         * Reads a component pool for the given component type from a snapshot.
+         *
+         * The pool must match the archetypes already read, every entity in the pool must be in an archetype with the component and vice versa.
+         *
+         * @tparam T The type of component.
+         *
+         * @param reader The snapshot reader, after the hash of the component.
+         *
+         * @throws std::runtime_error If the pool does not match the component type or the archetypes.
+         */
+        template <typename T>
+        void readSnapshotPool(SnapshotReader &reader)
+        {
+            ComponentId componentId = ComponentIdGenerator::id<T>;
+
+            if (hasComponentPool<T>())
+            {
+                throw std::runtime_error("Registry (readSnapshotPool): Snapshot has component '" + std::string(typeid(T).name()) + "' more than once.");
+            }
+
+            if (reader.read<uint64_t>() != sizeof(T))
+            {
+                throw std::runtime_error("Registry (readSnapshotPool): Component '" + std::string(typeid(T).name()) + "' has a different size in the snapshot.");
+            }
+
+            auto &componentPool = createComponentPool<T>();
+            componentPool.readSnapshot(reader, changeTick.load(std::memory_order_relaxed));
+
+            size_t expected = 0;
+            for (auto archetype : archetypes)
+            {
+                if (archetype->has(componentId))
+                {
+                    expected += archetype->size();
                 }
-                else
+            }
+
+            if (componentPool.size() != expected)
+            {
+                throw std::runtime_error("Registry (readSnapshotPool): Component '" + std::string(typeid(T).name()) + "' does not match the archetypes in the snapshot.");
+            }
+
+            // the ids are unique, so with the count matching every entity with the component is in the pool
+            for (auto entity : componentPool.getDenseIds())
+            {
+                if (!has(entity) || !getLocation(entity).archetype->has(componentId))
                 {
-                    // increment iterator
-                    it++;
+                    throw std::runtime_error("Registry (readSnapshotPool): Component '" + std::string(typeid(T).name()) + "' does not match the archetypes in the snapshot.");
                 }
             }
         }
 
+        /**
+         * The threshold for when to reset the timestamp of a cached entity view instead of adding to `addedSinceTimestamp` and `removedSinceTimestamp`.
+         */
+        size_t cacheUpdateInvalidationThreshold = 2500;
+
+        /**
+         * The component pools, indexed by component ID.
+         *
+         * These store sparse sets of components for each component type, components which have no pool yet are nullptr.
+         */
+        std::vector<SparseSetBase *> componentPools;
+
+        /**
+         * An empty vector of entities, returned for views which have not been cached.
+         */
+        inline static const std::vector<Entity> emptyEntities;
+
+        /**
+         * The cached entity views.
+         *
+         * The key is the sorted IDs of the view's components.
+         *
+         * The views are never destroyed before the registry, so pointers to them (i.e. persistent views) stay valid.
+         */
+        mutable boost::unordered_map<std::vector<ComponentId>, CachedView *> cachedViews;
+
+        std::vector<Group *> groups;
+
+        /**
+         * The group owning each component, indexed by component ID, nullptr for components which are not owned.
+         */
+        std::vector<Group *> groupsByComponent;
+
+        /**
+         * Gets the group owning the given component.
+         *
+         * @param componentId The ID of the component.
+         *
+         * @returns The group or nullptr if the component is not owned.
+         */
+        Group *getOwningGroup(ComponentId componentId) const
+        {
+            return componentId < groupsByComponent.size() ? groupsByComponent[componentId] : nullptr;
+        }
+
+        /**
+         * The job system used by parallelEach.
+         */
+        Core::JobSystem *jobSystem = nullptr;
+
+        /**
+         * The number of parallelEach loops and signal deliveries currently running, structural changes are rejected while this is not 0.
+         */
+        mutable std::atomic<size_t> structuralChangeLocks = 0;
+
+        /**
+         * The tick changes to components are currently recorded at.
+         *
+         * This starts at 1, so every component added is changed since tick 0.
+         */
+        mutable std::atomic<uint64_t> changeTick = 1;
+
+        /**
+         * Rejects structural changes to the registry while it exists.
+         */
+        struct StructuralChangeLock
+        {
+            const Registry &registry;
+
+            StructuralChangeLock(const Registry &registry) : registry(registry)
+            {
+                registry.structuralChangeLocks++;
+            }
+
+            ~StructuralChangeLock()
+            {
+                registry.structuralChangeLocks--;
+            }
+        };
+
+        /**
+         * Throws if structural changes are currently rejected.
+         *
+         * @param method The name of the method making the change.
+         *
+         * @throws std::runtime_error If a parallelEach loop or a signal listener is running.
+         */
+        void checkStructuralChange(const char *method) const;
+
+        /**
+         * The bus component signals are published on, mutable so listeners can subscribe through a const registry.
+         */
+        mutable Core::EventBus signals;
+
+        /**
+         * Publishes the constructed and destroyed signals of one component type, so they can be published for the components of an archetype.
+         */
+        struct ComponentSignalPublishers
+        {
+            void (*constructed)(const Registry &registry, std::span<const Entity> entities) = nullptr;
+            void (*destroyed)(const Registry &registry, std::span<const Entity> entities) = nullptr;
+        };
+
+        /**
+         * The signal publishers of each component type, indexed by component ID, set when the component's pool is first created.
+         */
+        std::vector<ComponentSignalPublishers> componentSignalPublishers;
+
+        /**
+         * Publishes a signal for an entity, if it has listeners.
+         *
+         * Structural changes are rejected while the listeners run.
+         *
+         * @tparam Signal The signal type, e.g. `ComponentConstructed<T>`.
+         *
+         * @param entity The entity.
+         */
+        template <typename Signal>
+        void publishSignal(Entity entity) const
+        {
+            if (!signals.hasListeners<Signal>())
+            {
+                return;
+            }
+
+            StructuralChangeLock lock(*this);
+            signals.publish(Signal{entity});
+        }
+
+        /**
+         * Publishes a signal for each of the entities, if it has listeners.
+         *
+         * @tparam Signal The signal type, e.g. `ComponentConstructed<T>`.
+         *
+         * @param registry The registry.
+         * @param entities The entities.
+         */
+        template <typename Signal>
+        static void publishSignals(const Registry &registry, std::span<const Entity> entities)
+        {
+            if (!registry.signals.hasListeners<Signal>())
+            {
+                return;
+            }
+
+            StructuralChangeLock lock(registry);
+
+            for (auto entity : entities)
+            {
+                registry.signals.publish(Signal{entity});
+            }
+        }
+
+        /**
+         * Publishes `ComponentConstructed` for each component of the archetype, for each of the given entities.
+         *
+         * @param archetype The archetype of the entities.
+         * @param entities The entities.
+         */
+        void publishConstructedSignals(const Archetype &archetype, std::span<const Entity> entities) const;
+
+        /**
+         * Publishes `ComponentDestroyed` for each component of the archetype, for each of the given entities.
+         *
+         * @param archetype The archetype of the entities.
+         * @param entities The entities.
+         */
+        void publishDestroyedSignals(const Archetype &archetype, std::span<const Entity> entities) const;
+
+        /**
+         * Guards the creation of cached views, so views can be requested from systems running in parallel.
+         *
+         * Structural changes (creating and destroying entities, adding and removing components) are not thread safe.
+         */
+        mutable std::mutex cachedViewsMutex;
+
         /**
          * Adds the given entity to the cached views for the given component.
          *
@@ -409,150 +1738,285 @@ namespace ECS
          * @param componentId The ID of the component.
          * @param e The entity to add to the cached views.
          */
-        void updateCachedViews(ComponentId componentId, ECS::Entity e)
+        void updateCachedViews(ComponentId componentId, ECS::Entity e);
+
+        /**
+         * Removes the given entity from the cached views for the given component.
+         *
+         * @tparam T The type of component.
+         *
+         * @param e The entity to remove from the cached views.
+         */
+        template <typename T>
+        void removeFromCachedViews(Entity e)
         {
-            for (auto &[components, view] : cachedViews)
-            {
-                if (!components.contains(componentId))
-                {
-                    continue;
-                }
+            auto componentId = ComponentIdGenerator::id<T>;
 
-                bool hasAllComponents = true;
+            removeFromCachedViews(componentId, e);
+        }
 
-                for (auto &componentId : components)
-                {
-                    if (!componentPools.contains(componentId))
-                    {
-                        hasAllComponents = false;
-                        break;
-                    }
+        /**
+         * Removes the given entity from the cached views for the given component.
+         *
+         * @param componentId The ID of the component.
+         * @param e The entity to remove from the cached views.
+         */
+        void removeFromCachedViews(ComponentId componentId, Entity e);
 
-                    auto componentPool = getComponentPool(componentId);
-                    if (!componentPool->has(e))
-                    {
-                        hasAllComponents = false;
-                        break;
-                    }
-                }
+        /**
+         * Removes the given entity from all cached views.
+         *
+         * @param e The entity to remove from the cached views.
+         */
+        void removeFromCachedViews(Entity e);
 
-                if (hasAllComponents)
-                {
-                    view.entities.push_back(e);
-                    view.addedSinceTimestamp.push_back(e);
+        /**
+         * Fills the given cached view with all the entities with its components and resets its timestamp.
+         *
+         * @param view The view to build.
+         */
+        void buildCachedView(CachedView &view) const;
 
-                    if (view.addedSinceTimestamp.size() > cacheUpdateInvalidationThreshold)
-                    {
-                        view.addedSinceTimestamp.clear();
-                        view.timestamp = Core::timeSinceEpochMicrosec();
-                    }
-                }
-            }
-        }
+        /**
+         * Adds the entity to the cached view.
+         *
+         * @param view The view.
+         * @param e The entity.
+         */
+        void addToCachedView(CachedView &view, Entity e);
 
         /**
-         * Helper function for to get cached views key.
+         * Removes the entity from the cached view, if it is in it.
          *
-         * @param t The type list.
-         * @param key The key to add to.
+         * @param view The view.
+         * @param e The entity.
+         */
+        void removeFromCachedView(CachedView &view, Entity e);
+
+        /**
+         * Resets the timestamp of the cached view and clears the entities added and removed since the timestamp,
+         * if more than `cacheUpdateInvalidationThreshold` entities have been added or removed.
          *
-         * @tparam T The type of component.
-         * @tparam Types The remaining types of components.
+         * @param view The view.
+         */
+        void checkCachedViewThreshold(CachedView &view);
+
+        /**
+         * Gets the cache key of the view of the given components.
+         *
+         * The key is the sorted and deduplicated component IDs, it is only computed once per set of types.
+         *
+         * @tparam Types The types of components.
+         *
+         * @returns The cache key.
          */
-        template <typename T, typename... Types>
-        void getCacheKey(TypeList<T, Types...> t, std::set<ComponentId> &key) const
+        template <typename... Types>
+        static const std::vector<ComponentId> &getViewKey()
         {
-            getCacheKey<T>(TypeList<T>{}, key);
-            getCacheKey<Types...>(TypeList<Types...>{}, key);
+            static const std::vector<ComponentId> key = createViewKey({ComponentIdGenerator::id<Types>...});
+
+            return key;
         }
 
         /**
-         * Helper function for to get cached views key.
+         * Gets the mask of the given components.
          *
-         * This is the base case for the recursion.
+         * The mask is created once per set of types.
          *
-         * @param t The type list.
-         * @param key The key to add to.
+         * @tparam Types The types of components.
          *
-         * @tparam T The type of component.
+         * @returns The mask of the components.
          */
-        template <typename T>
-        void getCacheKey(TypeList<T> t, std::set<ComponentId> &key) const
+        template <typename... Types>
+        static const ComponentMask &getViewMask()
         {
-            key.insert(ComponentIdGenerator::id<T>);
+            static const ComponentMask mask(getViewKey<Types...>());
+
+            return mask;
         }
 
         /**
-         * Helper function for view.
+         * Creates a view cache key from the given component IDs.
          *
-         * @tparam T The type of component.
-         * @tparam Types The remaining types of components.
+         * @param componentIds The component IDs.
+         *
+         * @returns The sorted and deduplicated component IDs.
+         */
+        static std::vector<ComponentId> createViewKey(std::vector<ComponentId> componentIds);
+
+        /**
+         * Gets the cached view with the given key, creating and building it if it does not exist.
          *
-         * @param entitySet The set of entities to add to.
-         * @param depth The depth of the recursion.
+         * @param key The cache key of the view.
+         *
+         * @returns The cached view.
+         */
+        CachedView &getCachedView(const std::vector<ComponentId> &key) const;
+
+        /**
+         * Finds the cached view with the given key.
+         *
+         * @param key The cache key of the view.
+         *
+         * @returns The cached view or nullptr if the view has not been cached.
+         */
+        const CachedView *findCachedView(const std::vector<ComponentId> &key) const;
+
+        /**
+         * Helper function for each and parallelEach.
+         *
+         * Finds the smallest component pool and iterates the entities in it.
+         *
+         * @tparam Pools The component pool types, const for const iteration.
+         *
+         * @param pools The component pools.
+         * @param func The function to call.
+         * @param grainSize The number of entities in each parallel chunk, or 0 to iterate on the calling thread.
+         * @param tick The change tick to record for the components of non const pools.
          */
-        template <typename T, typename... Types>
-        void viewHelper(TypeList<T, Types...> t, std::unordered_set<Entity> &entitySet, int depth = 0) const
+        template <typename... Pools, typename Func, size_t... Is>
+        void eachHelper(std::tuple<Pools *...> &pools, Func &func, size_t grainSize, uint64_t tick, std::index_sequence<Is...>) const
         {
-            viewHelper<T>(TypeList<T>{}, entitySet, depth);
-            viewHelper<Types...>(TypeList<Types...>{}, entitySet, depth + 1);
+            size_t sizes[] = {std::get<Is>(pools)->size()...};
+            size_t smallest = std::min_element(std::begin(sizes), std::end(sizes)) - std::begin(sizes);
+
+            // only the pool at the smallest index is iterated
+            ((smallest == Is && (eachFrom<Is>(pools, func, grainSize, tick, std::index_sequence<Is...>{}), true)) || ...);
         }
 
         /**
-         * Helper function for view.
+         * Helper function for each and parallelEach.
          *
-         * This is the base case for the recursion.
+         * Iterates the entities in the given pool, split into chunks on the job system if a grain size is given.
          *
-         * @tparam T The type of component.
+         * @tparam Driver The index of the pool to iterate.
+         * @tparam Pools The component pool types, const for const iteration.
          *
-         * @param entitySet The set of entities to add to.
-         * @param depth The depth of the recursion.
+         * @param pools The component pools.
+         * @param func The function to call.
+         * @param grainSize The number of entities in each parallel chunk, or 0 to iterate on the calling thread.
+         * @param tick The change tick to record for the components of non const pools.
          */
-        template <typename T>
-        void viewHelper(TypeList<T> t, std::unordered_set<Entity> &entitySet, int depth = 0) const
+        template <size_t Driver, typename... Pools, typename Func, size_t... Is>
+        void eachFrom(std::tuple<Pools *...> &pools, Func &func, size_t grainSize, uint64_t tick, std::index_sequence<Is...> seq) const
         {
-            // std::cout << "viewHelper: " << depth << std::endl;
-            // std::cout << "type name: " << typeid(T).name() << ", type id: " << ComponentIdGenerator::id<T> << std::endl;
+            size_t count = std::get<Driver>(pools)->size();
 
-            // no possible matches
-            if (!hasComponentPool<T>())
+            if (grainSize == 0 || jobSystem == nullptr || count <= grainSize)
             {
-                entitySet.clear();
+                eachInRange<Driver>(pools, func, 0, count, tick, seq);
                 return;
             }
 
-            const auto &entitiesT = getComponentPool<T>().getDenseIds();
+            StructuralChangeLock lock(*this);
 
-            if (depth == 0)
+            jobSystem->parallelFor(0, count, grainSize, [this, &pools, &func, tick, seq](size_t begin, size_t end)
+                                   { eachInRange<Driver>(pools, func, begin, end, tick, seq); });
+        }
+
+        /**
+         * Helper function for each and parallelEach.
+         *
+         * Iterates the entities in the given range of the pool and calls the function for those which are in every other pool.
+         *
+         * @tparam Driver The index of the pool to iterate.
+         * @tparam Pools The component pool types, const for const iteration.
+         *
+         * @param pools The component pools.
+         * @param func The function to call.
+         * @param begin The first index in the pool's dense vector.
+         * @param end The index after the last index in the pool's dense vector.
+         * @param tick The change tick to record for the components of non const pools.
+         */
+        template <size_t Driver, typename... Pools, typename Func, size_t... Is>
+        void eachInRange(std::tuple<Pools *...> &pools, Func &func, size_t begin, size_t end, uint64_t tick, std::index_sequence<Is...>) const
+        {
+            auto &driverPool = *std::get<Driver>(pools);
+            auto &ids = driverPool.getDenseIds();
+
+            for (size_t i = end; i-- > begin;)
             {
-                for (Entity entity : entitiesT)
+                Entity entity = ids[i];
+                uint32_t indices[] = {eachComponentIndex<Is, Driver>(pools, entity, i)...};
+
+                if (((indices[Is] != PagedIndexArray::NULL_INDEX) && ...))
                 {
-                    entitySet.insert(std::move(entity));
+                    func(entity, eachComponent(std::get<Is>(pools), indices[Is], tick)...);
                 }
             }
-            else
+        }
+
+        /**
+         * Helper function for eachGroup.
+         *
+         * @tparam Pools The owned component pool types, const for const iteration.
+         *
+         * @param size The number of entities in the group.
+         * @param pools The owned component pools.
+         * @param func The function to call.
+         * @param tick The change tick to record for the components of non const pools.
+         */
+        template <typename... Pools, typename Func>
+        void eachGroupHelper(size_t size, std::tuple<Pools *...> &pools, Func &func, uint64_t tick) const
+        {
+            auto &ids = std::get<0>(pools)->getDenseIds();
+
+            for (size_t i = 0; i < size; i++)
             {
-                // no possible matches
-                if (entitiesT.size() == 0 || entitySet.size() == 0)
-                {
-                    entitySet.clear();
-                    return;
-                }
+                std::apply([&](auto *...pool)
+                           { func(static_cast<Entity>(ids[i]), eachComponent(pool, i, tick)...); },
+                           pools);
+            }
+        }
 
-                // remove entities that don't have the component
-                std::unordered_set<Entity> entitySetT(entitiesT.begin(), entitiesT.end());
+        /**
+         * Helper function for each, parallelEach and eachGroup.
+         *
+         * Gets the component at the given index of the pool, recording it as changed at the given tick if the pool is not const.
+         *
+         * @param pool The component pool.
+         * @param index The index of the component in the pool's dense vector.
+         * @param tick The change tick to record.
+         *
+         * @returns The component, a const reference for const pools.
+         */
+        template <typename Pool>
+        static decltype(auto) eachComponent(Pool *pool, size_t index, uint64_t tick)
+        {
+            if constexpr (std::is_const_v<Pool>)
+            {
+                return pool->getAtIndex(index);
+            }
+            else
+            {
+                return pool->getChangedAtIndex(index, tick);
+            }
+        }
 
-                for (auto it = entitySet.begin(); it != entitySet.end();)
-                {
-                    if (!entitySetT.contains(*it))
-                    {
-                        it = entitySet.erase(it);
-                    }
-                    else
-                    {
-                        it++;
-                    }
-                }
+        /**
+         * Helper function for each.
+         *
+         * Gets the index of the entity's component in the dense vector of the pool at index I, the driving pool is indexed directly without a sparse lookup.
+         *
+         * @tparam I The index of the component pool.
+         * @tparam Driver The index of the pool being iterated.
+         *
+         * @param pools The component pools.
+         * @param entity The entity.
+         * @param denseIndex The index of the entity in the driving pool's dense vector.
+         *
+         * @returns The index of the component or PagedIndexArray::NULL_INDEX if the entity does not have it.
+         */
+        template <size_t I, size_t Driver, typename Pools>
+        uint32_t eachComponentIndex(Pools &pools, Entity entity, size_t denseIndex) const
+        {
+            if constexpr (I == Driver)
+            {
+                return static_cast<uint32_t>(denseIndex);
+            }
+            else
+            {
+                return std::get<I>(pools)->getIndex(entity);
             }
         }
 
@@ -570,15 +2034,30 @@ namespace ECS
         {
             ComponentId componentId = ComponentIdGenerator::id<T>;
 
-            if (componentPools.contains(componentId))
+            if (hasComponentPool(componentId))
             {
                 throw std::runtime_error("Registry (createComponentPool): Component pool already exists.");
             }
 
             SparseSet<T> *componentPool = new SparseSet<T>(maxEntities - 1);
 
+            if (componentId >= componentPools.size())
+            {
+                componentPools.resize(componentId + 1, nullptr);
+            }
+
             componentPools[componentId] = reinterpret_cast<SparseSetBase *>(componentPool);
 
+            if (componentId >= componentSignalPublishers.size())
+            {
+                componentSignalPublishers.resize(componentId + 1);
+            }
+
+            componentSignalPublishers[componentId] = ComponentSignalPublishers{
+                .constructed = &publishSignals<ComponentConstructed<T>>,
+                .destroyed = &publishSignals<ComponentDestroyed<T>>,
+            };
+
             return *componentPool;
         }
 
@@ -594,19 +2073,25 @@ namespace ECS
         template <typename T>
         SparseSet<T> &getComponentPool() const
         {
-            ComponentId componentId = ComponentIdGenerator::id<T>;
-
-            if (!componentPools.contains(componentId))
-            {
-                throw std::runtime_error("Registry (getComponentPool): Component pool does not exist.");
-            }
+            return *reinterpret_cast<SparseSet<T> *>(getComponentPool(ComponentIdGenerator::id<T>));
+        }
 
-            return *reinterpret_cast<SparseSet<T> *>(componentPools[componentId]);
+        /**
+         * Gets the component pool for the given component type, without checking that it exists.
+         *
+         * @tparam T The type of component.
+         *
+         * @returns The component pool.
+         */
+        template <typename T>
+        SparseSet<T> &getComponentPoolUnchecked() const
+        {
+            return *reinterpret_cast<SparseSet<T> *>(componentPools[ComponentIdGenerator::id<T>]);
         }
 
         SparseSetBase *getComponentPool(ComponentId componentId) const
         {
-            if (!componentPools.contains(componentId))
+            if (!hasComponentPool(componentId))
             {
                 throw std::runtime_error("Registry (getComponentPool): Component pool does not exist.");
             }
@@ -624,9 +2109,19 @@ namespace ECS
         template <typename T>
         bool hasComponentPool() const
         {
-            ComponentId componentId = ComponentIdGenerator::id<T>;
+            return hasComponentPool(ComponentIdGenerator::id<T>);
+        }
 
-            return componentPools.contains(componentId);
+        /**
+         * Returns whether or not the registry has a component pool for the given component.
+         *
+         * @param componentId The ID of the component.
+         *
+         * @returns Whether or not the registry has a component pool for the component.
+         */
+        bool hasComponentPool(ComponentId componentId) const
+        {
+            return componentId < componentPools.size() && componentPools[componentId] != nullptr;
         }
     };
 }
\ No newline at end of file
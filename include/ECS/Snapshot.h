@@ -0,0 +1,153 @@
+#pragma once
+
+#include <ostream>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * The first bytes of every snapshot, "REMI" in little endian.
+ */
+#define ECS_SNAPSHOT_MAGIC 0x494D4552
+
+/**
+ * The version of the snapshot format, snapshots of a different version cannot be read.
+ */
+#define ECS_SNAPSHOT_VERSION 2
+
+namespace ECS
+{
+    /**
+     * Writes a binary snapshot to a stream.
+     *
+     * Values are written in the native byte order and layout, so a snapshot can only be read by a build for the same platform.
+     */
+    class SnapshotWriter
+    {
+    public:
+        /**
+         * Creates a new snapshot writer.
+         *
+         * @param stream The stream to write to, opened in binary mode.
+         */
+        SnapshotWriter(std::ostream &stream);
+
+        /**
+         * Writes the magic number and version of the snapshot format, and the size of entity handles.
+         */
+        void writeHeader();
+
+        /**
+         * Writes raw bytes.
+         *
+         * @param data The bytes to write.
+         * @param size The number of bytes to write.
+         *
+         * @throws std::runtime_error If the stream fails.
+         */
+        void write(const void *data, size_t size);
+
+        /**
+         * Writes a value.
+         *
+         * @tparam T The type of value, must be trivially copyable.
+         *
+         * @param value The value to write.
+         *
+         * @throws std::runtime_error If the stream fails.
+         */
+        template <typename T>
+        void write(const T &value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "SnapshotWriter (write): Only trivially copyable values can be written.");
+
+            write(&value, sizeof(T));
+        }
+
+    private:
+        std::ostream &stream;
+    };
+
+    /**
+     * Reads a binary snapshot from memory, usually a memory mapped file (see remi::MappedFile).
+     *
+     * Reads are bounds checked, so a truncated or corrupt snapshot throws instead of reading past the end of the memory.
+     * The memory is not required to be aligned, values are copied out of it.
+     */
+    class SnapshotReader
+    {
+    public:
+        /**
+         * Creates a new snapshot reader.
+         *
+         * The memory must outlive the reader and anything read from it.
+         *
+         * @param data The snapshot.
+         * @param size The size of the snapshot in bytes.
+         */
+        SnapshotReader(const std::byte *data, size_t size);
+
+        /**
+         * Reads and checks the magic number and version of the snapshot format, and the size of entity handles.
+         *
+         * @throws std::runtime_error If the memory is not a snapshot, is a snapshot of a different version or was written with a different ECS_ENTITY_BITS.
+         */
+        void readHeader();
+
+        /**
+         * Reads raw bytes.
+         *
+         * @param size The number of bytes to read.
+         *
+         * @returns A pointer to the bytes in the snapshot's memory.
+         *
+         * @throws std::runtime_error If there are not enough bytes left.
+         */
+        const std::byte *read(size_t size);
+
+        /**
+         * Reads an array of elements.
+         *
+         * @param count The number of elements.
+         * @param elementSize The size of each element in bytes.
+         *
+         * @returns A pointer to the first element in the snapshot's memory.
+         *
+         * @throws std::runtime_error If there are not enough bytes left.
+         */
+        const std::byte *readArray(uint64_t count, size_t elementSize);
+
+        /**
+         * Reads a value.
+         *
+         * @tparam T The type of value, must be trivially copyable.
+         *
+         * @returns The value.
+         *
+         * @throws std::runtime_error If there are not enough bytes left.
+         */
+        template <typename T>
+        T read()
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "SnapshotReader (read): Only trivially copyable values can be read.");
+
+            T value;
+            std::memcpy(&value, read(sizeof(T)), sizeof(T));
+
+            return value;
+        }
+
+        /**
+         * Returns the number of bytes left to read.
+         *
+         * @returns The number of bytes left to read.
+         */
+        size_t getRemaining() const;
+
+    private:
+        const std::byte *data;
+        size_t size;
+        size_t offset = 0;
+    };
+}
\ No newline at end of file
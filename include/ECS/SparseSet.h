@@ -5,12 +5,35 @@
 #include <string>
 #include <iostream>
 #include <algorithm>
-
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "Entity.h"
+#include "PagedIndexArray.h"
+#include "ComponentStorage.h"
+#include "Snapshot.h"
 #include "../Physics/Collider2D.h"
 
 #define ECS_SPARSE_SET_MAX_ID 16777215
 #define ECS_SPARSE_SET_DEFAULT_MAX_ID 65535
 
+/**
+ * Whether `get` on sparse sets and registries validates that the component exists, 1 or 0.
+ *
+ * With checks, a missing component throws. Without them, `get` is a direct sparse lookup and a missing component is undefined behaviour,
+ * so use `has` or `tryGet` wherever the component may be missing.
+ *
+ * By default checks are kept in debug builds and compiled out when NDEBUG is defined.
+ */
+#ifndef ECS_CHECKED_ACCESS
+#ifdef NDEBUG
+#define ECS_CHECKED_ACCESS 0
+#else
+#define ECS_CHECKED_ACCESS 1
+#endif
+#endif
+
 namespace ECS
 {
 
@@ -25,7 +48,7 @@ namespace ECS
          *
          * @param id The ID of the item to remove.
          */
-        virtual void remove(size_t id) = 0;
+        virtual void remove(Entity id) = 0;
 
         /**
          * Checks if the sparse set contains the given id.
@@ -34,18 +57,34 @@ namespace ECS
          *
          * @returns Whether or not the sparse set contains the given id.
          */
-        virtual bool has(size_t id) = 0;
+        virtual bool has(Entity id) = 0;
 
         /**
          * Returns the number of items in the set.
          *
          * @returns The number of items in the set.
          */
-        virtual size_t size() = 0;
+        virtual size_t size() const = 0;
+
+        /**
+         * Gets the index of an item in the dense vector.
+         *
+         * @param id The ID of the item.
+         *
+         * @returns The index of the item or PagedIndexArray::NULL_INDEX if the ID does not exist in the set.
+         */
+        virtual uint32_t getIndex(Entity id) const = 0;
+
+        /**
+         * Swaps the positions of two items in the dense vector.
+         *
+         * @param indexA The index of the first item.
+         * @param indexB The index of the second item.
+         */
+        virtual void swap(size_t indexA, size_t indexB) = 0;
 
     protected:
         size_t maxId = 0;
-        size_t NULL_INDEX = 0;
     };
 
     /**
@@ -53,21 +92,38 @@ namespace ECS
      *
      * The sparse vector is an integer array where each value is an index into the dense vector.
      *
-     * The index in the sparse vector is the ID of the item we want to store.
+     * The index in the sparse vector is the slot index of the ID of the item we want to store, i.e. the entity's index without its generation (see Entity).
+     * The dense vector stores the full IDs, so an ID of an earlier generation is not found in the set.
+     *
+     * The sparse vector is paged (see PagedIndexArray), so memory is only allocated for the ranges of IDs that are actually used.
      *
      * The dense vector is a tightly packed unsorted array of the data we want to store for the ids i.e. entities.
+     * Its layout is chosen by the ComponentStorage trait of the type, for struct of arrays layout items are accessed through an SoARef instead of a reference.
+     * Tag components (see isTagComponent) have no dense storage, their set only keeps the dense ids, change ticks and sparse vector.
      *
      * The data in the set should not be pointer data for efficient cache usage.
      */
     template <typename T>
-    class SparseSet : private SparseSetBase
+    class SparseSet final : private SparseSetBase
     {
     public:
+        /**
+         * The type used to access an item, `T &` or `SoARef<T>` for struct of arrays layout.
+         */
+        using Reference = typename DenseStorage<T>::Reference;
+
+        /**
+         * The type used to read an item, `const T &` or `SoARef<T, true>` for struct of arrays layout.
+         */
+        using ConstReference = typename DenseStorage<T>::ConstReference;
+
         /**
          * Creates a new sparse set.
          *
          * The max ID cannot be changed after the sparse set is created.
          *
+         * No memory is allocated for the sparse vector until items are added, so a large max ID is cheap.
+         *
          * @param maxId The maximum ID of the items we want to store, by default this is ECS_SPARSE_SET_DEFAULT_MAX_ID (65535). The max value is ECS_SPARSE_SET_MAX_ID.
          */
         SparseSet(size_t maxId = ECS_SPARSE_SET_DEFAULT_MAX_ID)
@@ -78,18 +134,6 @@ namespace ECS
             }
 
             this->maxId = maxId;
-            NULL_INDEX = maxId + 1;
-
-            try
-            {
-                denseIds = std::vector<size_t>();
-                dense = std::vector<T>();
-                sparse = std::vector<size_t>(maxId + 1, NULL_INDEX);
-            }
-            catch (std::bad_alloc &e)
-            {
-                throw std::runtime_error("SparseSet (SparseSet): Could not allocate memory for sparse set for type '" + std::string(typeid(T).name()) + "'.");
-            }
         }
 
         /**
@@ -107,26 +151,47 @@ namespace ECS
          * If the ID already exists, the old item will be overwritten.
          *
          * @param id The ID of the item to add.
-         * @param item The item to add.
+         * @param item The item to add, it is moved into the set.
+         * @param changeTick The tick to record as the item's last change.
+         */
+        void add(Entity id, T item, uint64_t changeTick = 0)
+        {
+            emplace(id, changeTick, std::move(item));
+        }
+
+        /**
+         * Constructs an item in the sparse set.
+         *
+         * A new item is constructed in place at the back of the dense vector.
+         * If the ID already exists, the old item is overwritten by an item constructed from the arguments.
+         *
+         * @param id The ID of the item.
+         * @param changeTick The tick to record as the item's last change.
+         * @param args The arguments to construct the item with.
          */
-        void add(size_t id, T item)
+        template <typename... Args>
+        void emplace(Entity id, uint64_t changeTick, Args &&...args)
         {
-            if (id > maxId)
+            if (entityIndex(id) > maxId)
             {
-                throw std::runtime_error("SparseSet (add): ID is greater than max ID.");
+                throw std::runtime_error("SparseSet (emplace): ID is greater than max ID.");
             }
 
             if (has(id))
             {
                 // update the value at the dense vector
-                dense[sparse[id]] = item;
+                uint32_t index = sparse.get(entityIndex(id));
+
+                dense.set(index, T(std::forward<Args>(args)...));
+                changeTicks[index] = changeTick;
             }
             else
             {
-                // add the item to the dense vector
+                // construct the item at the back of the dense vector, before the ids so a throwing constructor leaves the set unchanged
+                dense.emplace_back(std::forward<Args>(args)...);
                 denseIds.push_back(id);
-                dense.push_back(item);
-                sparse[id] = dense.size() - 1;
+                changeTicks.push_back(changeTick);
+                sparse.set(entityIndex(id), static_cast<uint32_t>(dense.size() - 1));
             }
         }
 
@@ -137,60 +202,365 @@ namespace ECS
          *
          * @param id The ID of the item to remove.
          */
-        void remove(size_t id)
+        void remove(Entity id)
         {
             if (!has(id))
             {
                 return;
             }
 
-            if (denseIds.back() == id)
-            {
-                // if we are removing the last item in the set, we can just pop it off the dense vector
-                dense.pop_back();
-                denseIds.pop_back();
-                sparse[id] = NULL_INDEX;
-
-                return;
-            }
-
-            size_t index = sparse[id];
-
-            // swap the item we want to remove with the last item in the dense vector
+            uint32_t index = sparse.get(entityIndex(id));
             auto lastIndex = dense.size() - 1;
-            auto last = dense[lastIndex];
             auto lastId = denseIds[lastIndex];
 
-            dense[lastIndex] = dense[index];
-            denseIds[lastIndex] = denseIds[index];
+            // move the last item into the removed item's place, this is a no-op if the item is the last
+            dense.swapRemove(index);
 
-            dense[index] = std::move(last);
             denseIds[index] = lastId;
+            denseIds.pop_back();
+
+            changeTicks[index] = changeTicks[lastIndex];
+            changeTicks.pop_back();
 
             // update the sparse vector
-            sparse[lastId] = index;
-            sparse[id] = NULL_INDEX;
+            if (lastId != id)
+            {
+                sparse.set(entityIndex(lastId), index);
+            }
 
-            // remove the last item in the dense vector (which is the item we want to remove)
-            dense.pop_back();
-            denseIds.pop_back();
+            sparse.reset(entityIndex(id));
         }
 
         /**
          * Gets an item from the sparse set.
          *
+         * The ID is only validated when ECS_CHECKED_ACCESS is enabled.
+         *
          * @param id The ID of the item to get.
          *
          * @returns A reference to the item.
+         *
+         * @throws std::runtime_error If the ID does not exist in the set and ECS_CHECKED_ACCESS is enabled.
          */
-        T &get(size_t id)
+        Reference get(Entity id)
         {
+#if ECS_CHECKED_ACCESS
             if (!has(id))
             {
                 throw std::runtime_error("SparseSet (get): ID '" + std::to_string(id) + "' does not exist in sparse set, for type '" + typeid(T).name() + "'.");
             }
+#endif
+
+            return getUnchecked(id);
+        }
+
+        /**
+         * Gets an item from the sparse set without validating the ID.
+         *
+         * The ID must exist in the set, otherwise the behaviour is undefined.
+         *
+         * @param id The ID of the item to get.
+         *
+         * @returns A reference to the item.
+         */
+        Reference getUnchecked(Entity id)
+        {
+            return dense.at(sparse.get(entityIndex(id)));
+        }
 
-            return dense[sparse[id]];
+        /**
+         * Gets an item from the sparse set for reading without validating the ID.
+         *
+         * The ID must exist in the set, otherwise the behaviour is undefined.
+         *
+         * @param id The ID of the item to get.
+         *
+         * @returns A const reference to the item.
+         */
+        ConstReference getUnchecked(Entity id) const
+        {
+            return dense.at(sparse.get(entityIndex(id)));
+        }
+
+        /**
+         * Gets an item from the sparse set and records the given tick as its last change.
+         *
+         * The ID is only validated when ECS_CHECKED_ACCESS is enabled.
+         *
+         * @param id The ID of the item to get.
+         * @param changeTick The tick to record.
+         *
+         * @returns A reference to the item.
+         *
+         * @throws std::runtime_error If the ID does not exist in the set and ECS_CHECKED_ACCESS is enabled.
+         */
+        Reference getChanged(Entity id, uint64_t changeTick)
+        {
+#if ECS_CHECKED_ACCESS
+            if (!has(id))
+            {
+                throw std::runtime_error("SparseSet (getChanged): ID '" + std::to_string(id) + "' does not exist in sparse set, for type '" + typeid(T).name() + "'.");
+            }
+#endif
+
+            return getChangedUnchecked(id, changeTick);
+        }
+
+        /**
+         * Gets an item from the sparse set and records the given tick as its last change, without validating the ID.
+         *
+         * The ID must exist in the set, otherwise the behaviour is undefined.
+         *
+         * @param id The ID of the item to get.
+         * @param changeTick The tick to record.
+         *
+         * @returns A reference to the item.
+         */
+        Reference getChangedUnchecked(Entity id, uint64_t changeTick)
+        {
+            uint32_t index = sparse.get(entityIndex(id));
+            changeTicks[index] = changeTick;
+
+            return dense.at(index);
+        }
+
+        /**
+         * Gets the tick the item with the given ID was last changed at.
+         *
+         * @param id The ID of the item.
+         *
+         * @returns The tick the item was last changed at.
+         */
+        uint64_t getChangeTick(Entity id)
+        {
+            if (!has(id))
+            {
+                throw std::runtime_error("SparseSet (getChangeTick): ID '" + std::to_string(id) + "' does not exist in sparse set, for type '" + typeid(T).name() + "'.");
+            }
+
+            return changeTicks[sparse.get(entityIndex(id))];
+        }
+
+        /**
+         * Records the given tick as the last change of the item with the given ID.
+         *
+         * If the ID does not exist, nothing will happen.
+         *
+         * @param id The ID of the item.
+         * @param changeTick The tick to record.
+         */
+        void setChangeTick(Entity id, uint64_t changeTick)
+        {
+            uint32_t index = getIndex(id);
+
+            if (index == PagedIndexArray::NULL_INDEX)
+            {
+                return;
+            }
+
+            changeTicks[index] = changeTick;
+        }
+
+        /**
+         * Gets an item from the sparse set if it exists.
+         *
+         * Unlike `get`, this will not throw and only performs a single sparse lookup.
+         *
+         * Only available for array of structs layout, use `getIndex` otherwise.
+         *
+         * @param id The ID of the item to get.
+         *
+         * @returns A pointer to the item or nullptr if the ID does not exist in the set.
+         */
+        T *tryGet(Entity id)
+            requires(!isSoAComponent<T>)
+        {
+            uint32_t index = getIndex(id);
+
+            if (index == PagedIndexArray::NULL_INDEX)
+            {
+                return nullptr;
+            }
+
+            return &dense.at(index);
+        }
+
+        /**
+         * Gets an item from the sparse set if it exists, and records the given tick as its last change.
+         *
+         * Only available for array of structs layout, use `getIndex` otherwise.
+         *
+         * @param id The ID of the item to get.
+         * @param changeTick The tick to record.
+         *
+         * @returns A pointer to the item or nullptr if the ID does not exist in the set.
+         */
+        T *tryGetChanged(Entity id, uint64_t changeTick)
+            requires(!isSoAComponent<T>)
+        {
+            uint32_t index = getIndex(id);
+
+            if (index == PagedIndexArray::NULL_INDEX)
+            {
+                return nullptr;
+            }
+
+            changeTicks[index] = changeTick;
+
+            return &dense.at(index);
+        }
+
+        /**
+         * Gets the index of an item in the dense vector.
+         *
+         * This will not throw and only performs a single sparse lookup.
+         *
+         * @param id The ID of the item.
+         *
+         * @returns The index of the item or PagedIndexArray::NULL_INDEX if the ID does not exist in the set.
+         */
+        uint32_t getIndex(Entity id) const
+        {
+            uint32_t index = sparse.get(entityIndex(id));
+
+            // the slot may hold an item of a different generation
+            if (index == PagedIndexArray::NULL_INDEX || denseIds[index] != id)
+            {
+                return PagedIndexArray::NULL_INDEX;
+            }
+
+            return index;
+        }
+
+        /**
+         * Swaps the positions of two items in the dense vector.
+         *
+         * No bounds checking is performed.
+         *
+         * @param indexA The index of the first item.
+         * @param indexB The index of the second item.
+         */
+        void swap(size_t indexA, size_t indexB)
+        {
+            if (indexA == indexB)
+            {
+                return;
+            }
+
+            dense.swap(indexA, indexB);
+            std::swap(denseIds[indexA], denseIds[indexB]);
+            std::swap(changeTicks[indexA], changeTicks[indexB]);
+
+            sparse.set(entityIndex(denseIds[indexA]), static_cast<uint32_t>(indexA));
+            sparse.set(entityIndex(denseIds[indexB]), static_cast<uint32_t>(indexB));
+        }
+
+        /**
+         * Sorts the items in the dense vector.
+         *
+         * The items keep their ids, only their order in the dense vector changes, so iterating the dense vector visits them in sorted order.
+         *
+         * @tparam Compare The comparator, `bool(ConstReference a, ConstReference b)` returning whether a goes before b.
+         *
+         * @param compare The comparator.
+         */
+        template <typename Compare>
+        void sort(Compare compare)
+        {
+            sort(0, dense.size(), compare);
+        }
+
+        /**
+         * Sorts the items in a range of the dense vector.
+         *
+         * @tparam Compare The comparator, `bool(ConstReference a, ConstReference b)` returning whether a goes before b.
+         *
+         * @param begin The index of the first item to sort.
+         * @param end The index after the last item to sort.
+         * @param compare The comparator.
+         */
+        template <typename Compare>
+        void sort(size_t begin, size_t end, Compare compare)
+        {
+            if (end - begin < 2)
+            {
+                return;
+            }
+
+            const auto &items = dense;
+
+            // sort the indices rather than the items, then move each item once
+            std::vector<size_t> order(end - begin);
+            for (size_t i = 0; i < order.size(); i++)
+            {
+                order[i] = begin + i;
+            }
+
+            std::sort(order.begin(), order.end(), [&items, &compare](size_t a, size_t b)
+                      { return compare(items.at(a), items.at(b)); });
+
+            // follow each cycle of the permutation, the item at current is always the item that started at i
+            for (size_t i = begin; i < end; i++)
+            {
+                size_t current = i;
+
+                while (order[current - begin] != i)
+                {
+                    size_t next = order[current - begin];
+
+                    swap(current, next);
+                    order[current - begin] = current;
+
+                    current = next;
+                }
+
+                order[current - begin] = current;
+            }
+        }
+
+        /**
+         * Gets the item at the given index in the dense vector.
+         *
+         * No bounds checking is performed.
+         *
+         * @param index The index of the item in the dense vector.
+         *
+         * @returns A reference to the item.
+         */
+        Reference getAtIndex(size_t index)
+        {
+            return dense.at(index);
+        }
+
+        /**
+         * Gets the item at the given index in the dense vector and records the given tick as its last change.
+         *
+         * No bounds checking is performed.
+         *
+         * @param index The index of the item in the dense vector.
+         * @param changeTick The tick to record.
+         *
+         * @returns A reference to the item.
+         */
+        Reference getChangedAtIndex(size_t index, uint64_t changeTick)
+        {
+            changeTicks[index] = changeTick;
+
+            return dense.at(index);
+        }
+
+        /**
+         * Gets the item at the given index in the dense vector for reading.
+         *
+         * No bounds checking is performed.
+         *
+         * @param index The index of the item in the dense vector.
+         *
+         * @returns A const reference to the item.
+         */
+        ConstReference getAtIndex(size_t index) const
+        {
+            return dense.at(index);
         }
 
         /**
@@ -200,14 +570,14 @@ namespace ECS
          *
          * @returns Whether or not the sparse set has an item with the given ID.
          */
-        bool has(size_t id)
+        bool has(Entity id)
         {
-            if (id > maxId)
+            if (entityIndex(id) > maxId)
             {
                 throw std::runtime_error("SparseSet (has): ID is greater than max ID.");
             }
 
-            return sparse[id] != NULL_INDEX;
+            return getIndex(id) != PagedIndexArray::NULL_INDEX;
         }
 
         /**
@@ -217,19 +587,50 @@ namespace ECS
          *
          * @returns The number of items in the set.
          */
-        size_t size()
+        size_t size() const
         {
             return dense.size();
         }
 
+        /**
+         * Reserves capacity for the given number of items, so adding up to that many items does not reallocate.
+         *
+         * @param capacity The number of items.
+         */
+        void reserve(size_t capacity)
+        {
+            denseIds.reserve(capacity);
+            dense.reserve(capacity);
+            changeTicks.reserve(capacity);
+        }
+
         /**
          * Returns the dense vector.
          *
+         * Only available for array of structs layout, use `getColumn` otherwise. Tag components have no dense vector.
+         *
          * @returns The dense vector.
          */
         const std::vector<T> &getDense()
+            requires(!isSoAComponent<T> && !isTagComponent<T>)
+        {
+            return dense.getData();
+        }
+
+        /**
+         * Returns the column storing the given member of every item.
+         *
+         * Only available for struct of arrays layout. The column is parallel to the dense ids vector.
+         *
+         * @tparam Field The member pointer, e.g. `&Particle::position`.
+         *
+         * @returns The column.
+         */
+        template <auto Field>
+        auto &getColumn()
+            requires(isSoAComponent<T>)
         {
-            return dense;
+            return dense.template getColumn<Field>();
         }
 
         /**
@@ -239,25 +640,130 @@ namespace ECS
          *
          * @returns The dense ids vector.
          */
-        const std::vector<size_t> &getDenseIds()
+        const std::vector<Entity> &getDenseIds() const
         {
             return denseIds;
         }
 
+        /**
+         * Returns the change ticks vector.
+         *
+         * This is parallel to the dense vector, so the tick at an index is the last change of the item at the same index in the dense vector.
+         *
+         * @returns The change ticks vector.
+         */
+        const std::vector<uint64_t> &getChangeTicks() const
+        {
+            return changeTicks;
+        }
+
+        /**
+         * Writes the ids and items of the set to a snapshot.
+         *
+         * Items stored as an array of structs are written with a single copy of the dense vector.
+         *
+         * @param writer The snapshot writer.
+         */
+        void writeSnapshot(SnapshotWriter &writer)
+            requires(std::is_trivially_copyable_v<T>)
+        {
+            writer.write<uint64_t>(denseIds.size());
+            writer.write(denseIds.data(), denseIds.size() * sizeof(Entity));
+
+            // tags have no dense vector, they are written as the bytes of empty objects, so the format does not depend on the storage
+            if constexpr (isSoAComponent<T> || isTagComponent<T>)
+            {
+                for (size_t i = 0; i < dense.size(); i++)
+                {
+                    writer.write<T>(dense.at(i));
+                }
+            }
+            else
+            {
+                writer.write(dense.getData().data(), dense.size() * sizeof(T));
+            }
+        }
+
+        /**
+         * Reads ids and items written by `writeSnapshot` into the set.
+         *
+         * The set must be empty. Items stored as an array of structs are filled with a single copy from the snapshot.
+         *
+         * @param reader The snapshot reader.
+         * @param changeTick The tick to record as the last change of every item.
+         *
+         * @throws std::runtime_error If the set is not empty, or the snapshot is truncated or has invalid ids. The set must then be discarded.
+         */
+        void readSnapshot(SnapshotReader &reader, uint64_t changeTick)
+            requires(std::is_trivially_copyable_v<T>)
+        {
+            if (dense.size() != 0)
+            {
+                throw std::runtime_error("SparseSet (readSnapshot): Sparse set is not empty.");
+            }
+
+            auto count = reader.read<uint64_t>();
+            auto ids = reader.readArray(count, sizeof(Entity));
+            auto items = reader.readArray(count, sizeof(T));
+
+            if (count > maxId + 1)
+            {
+                throw std::runtime_error("SparseSet (readSnapshot): Snapshot has more items than the max ID allows.");
+            }
+
+            denseIds.resize(count);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Entity id;
+                std::memcpy(&id, ids + i * sizeof(Entity), sizeof(Entity));
+
+                if (entityIndex(id) > maxId || sparse.get(entityIndex(id)) != PagedIndexArray::NULL_INDEX)
+                {
+                    throw std::runtime_error("SparseSet (readSnapshot): Snapshot has an invalid or duplicate ID '" + std::to_string(id) + "'.");
+                }
+
+                denseIds[i] = id;
+                sparse.set(entityIndex(id), static_cast<uint32_t>(i));
+            }
+
+            if constexpr (isSoAComponent<T>)
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    T item;
+                    std::memcpy(&item, items + i * sizeof(T), sizeof(T));
+
+                    dense.push_back(item);
+                }
+            }
+            else
+            {
+                dense.assign(items, count);
+            }
+
+            changeTicks.assign(count, changeTick);
+        }
+
     private:
         /**
          * A parrallel vector to the dense vector that stores the ID of the item at the matching index in the dense vector.
          */
-        std::vector<size_t> denseIds;
+        std::vector<Entity> denseIds;
 
         /**
          * The dense vector.
          */
-        std::vector<T> dense;
+        DenseStorage<T> dense;
+
+        /**
+         * A parrallel vector to the dense vector that stores the tick each item was last changed at.
+         */
+        std::vector<uint64_t> changeTicks;
 
         /**
          * The sparse vector.
          */
-        std::vector<size_t> sparse;
+        PagedIndexArray sparse;
     };
 }
\ No newline at end of file
@@ -5,6 +5,9 @@
 #include "../Core/Timestep.h"
 #include "../Audio/SoundEffectManager.h"
 #include "../Audio/MusicManager.h"
+#include "Component.h"
+
+#include <set>
 
 namespace World
 {
@@ -19,6 +22,7 @@ namespace Physics
 namespace Core
 {
     class SpaceTransformer;
+    class JobSystem;
 }
 
 namespace ECS
@@ -27,10 +31,35 @@ namespace ECS
      * Represents a system that can be updated.
      *
      * A system is used to update the world.
+     *
+     * Systems can declare which components they read and write, using `declareRead` and `declareWrite` in their constructor.
+     * The world will run systems whose declared access does not conflict at the same time on different threads.
+     *
+     * A system which declares its access must only get and modify the components it has declared, and must not
+     * create or destroy entities, add or remove components or modify the scene graph or world.
+     *
+     * Getting a component through a non const registry records a change tick for it, so components which are only
+     * declared as read must be accessed through the const registry, e.g. `std::as_const(world).getRegistry()`.
+     *
+     * Systems which do not declare any access are exclusive, they never run at the same time as any other system.
      */
     class System
     {
     public:
+        /**
+         * The components a system reads and writes.
+         */
+        struct ComponentAccess
+        {
+            std::set<ComponentId> reads;
+            std::set<ComponentId> writes;
+
+            /**
+             * Whether or not the system must run on its own.
+             */
+            bool exclusive = true;
+        };
+
         struct SystemUpdateData
         {
             World::World &world;
@@ -43,6 +72,8 @@ namespace ECS
 
             const Audio::SoundEffectManager &soundEffectManager;
             const Audio::MusicManager &musicManager;
+
+            Core::JobSystem &jobSystem;
         };
 
         virtual ~System() = default;
@@ -60,5 +91,129 @@ namespace ECS
          * @param data The system update data, holds references to the world, physics world, space transformer, and timestep.
          */
         virtual void fixedUpdate(const SystemUpdateData &data) {};
+
+        /**
+         * Gets the components the system reads and writes.
+         *
+         * @returns The component access of the system.
+         */
+        const ComponentAccess &getComponentAccess() const
+        {
+            return componentAccess;
+        }
+
+        /**
+         * Returns whether or not the system can not run at the same time as the given system.
+         *
+         * Two systems conflict if either is exclusive or one writes a component the other reads or writes.
+         *
+         * @param other The other system.
+         *
+         * @returns Whether or not the systems conflict.
+         */
+        bool conflictsWith(const System &other) const
+        {
+            auto &a = componentAccess;
+            auto &b = other.componentAccess;
+
+            if (a.exclusive || b.exclusive)
+            {
+                return true;
+            }
+
+            for (auto id : a.writes)
+            {
+                if (b.reads.contains(id) || b.writes.contains(id))
+                {
+                    return true;
+                }
+            }
+
+            for (auto id : b.writes)
+            {
+                if (a.reads.contains(id))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /**
+         * Gets the number of entities the system reported touching since this was last called, and resets it.
+         *
+         * The world calls this after each update to record it in the system's stats.
+         *
+         * @returns The number of entities touched.
+         */
+        size_t takeTouchedEntities()
+        {
+            size_t touched = touchedEntities;
+            touchedEntities = 0;
+
+            return touched;
+        }
+
+    protected:
+        /**
+         * Declares that the system reads the given component.
+         *
+         * This makes the system non exclusive.
+         *
+         * The component must only be accessed through the const registry, since non const access records a change tick,
+         * which is a data race with other systems reading the component and reports the read as a change.
+         *
+         * @tparam T The type of component.
+         */
+        template <typename T>
+        void declareRead()
+        {
+            componentAccess.reads.insert(ComponentIdGenerator::id<T>);
+            componentAccess.exclusive = false;
+        }
+
+        /**
+         * Declares that the system reads and writes the given component.
+         *
+         * This makes the system non exclusive.
+         *
+         * @tparam T The type of component.
+         */
+        template <typename T>
+        void declareWrite()
+        {
+            componentAccess.writes.insert(ComponentIdGenerator::id<T>);
+            componentAccess.exclusive = false;
+        }
+
+        /**
+         * Sets whether or not the system must run on its own.
+         *
+         * This can be used to make a system which does not access any components run in parallel with other systems.
+         *
+         * @param exclusive Whether or not the system is exclusive.
+         */
+        void setExclusive(bool exclusive)
+        {
+            componentAccess.exclusive = exclusive;
+        }
+
+        /**
+         * Reports that the system touched the given number of entities in the current update.
+         *
+         * This is only used for the system's stats, see `World::World::getSystemStats`.
+         *
+         * @param count The number of entities.
+         */
+        void addTouchedEntities(size_t count)
+        {
+            touchedEntities += count;
+        }
+
+    private:
+        ComponentAccess componentAccess;
+
+        size_t touchedEntities = 0;
     };
 }
\ No newline at end of file
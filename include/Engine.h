@@ -9,6 +9,7 @@
 #include "Input/Mouse.h"
 #include "Input/Keyboard.h"
 #include "Core/SpaceTransformer.h"
+#include "Core/JobSystem.h"
 #include "Physics/PhysicsWorld.h"
 #include "World/World.h"
 #include "Physics/MouseJointUpdateSystem.h"
@@ -126,6 +127,24 @@ namespace remi
          */
         size_t maxEntities = 65536;
 
+        /**
+         * The number of worker threads in the engine's job system.
+         *
+         * The main thread also runs jobs while it waits for them, so 0 runs everything on the main thread.
+         *
+         * By default this is one less than the number of hardware threads (0 on emscripten).
+         *
+         * Changing this after engine creation will not change the number of workers.
+         */
+        unsigned int workerThreads = Core::JobSystem::getDefaultWorkerCount();
+
+        /**
+         * Whether to pin each worker thread of the job system to its own core.
+         *
+         * Changing this after engine creation will not change the affinity of the workers.
+         */
+        bool pinWorkerThreads = false;
+
         /**
          * The configuration of the physics world.
          */
@@ -245,6 +264,16 @@ namespace remi
          */
         Physics::PhysicsWorld *const getPhysicsWorld();
 
+        /**
+         * Gets the job system of the engine.
+         *
+         * This is used to run the world's non conflicting systems in parallel, and can be used by systems, render passes and asset loading
+         * to run their own jobs.
+         *
+         * @returns The job system of the engine.
+         */
+        Core::JobSystem *const getJobSystem();
+
         /**
          * Gets the world of the engine.
          *
@@ -331,6 +360,7 @@ namespace remi
 
         Physics::PhysicsWorld *physicsWorld = nullptr;
         World::World *world = nullptr;
+        Core::JobSystem *jobSystem = nullptr;
 
         Input::Mouse *mouse = nullptr;
         Input::Keyboard *keyboard = nullptr;
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "../Core/Window.h"
-#include "../Core/Observer.h"
+#include "../Core/Subject.h"
 
 #include <vector>
 
@@ -484,7 +484,7 @@ namespace Input
      *  - Keyboard::KeyDownEvent
      *  - Keyboard::KeyUpEvent
      */
-    class Keyboard : public Core::Observer<const std::vector<SDL_Event> &>, public Core::Subject<Key>
+    class Keyboard : public Core::Subject<Key>
     {
     public:
         static constexpr std::string KeyDownEvent = "keydown";
@@ -525,12 +525,11 @@ namespace Input
         /**
          * Update the keyboard with new events.
          *
-         * This will be attached to the "poll" event of the window.
+         * This is subscribed to the WindowPollEvent of the window.
          *
-         * @param event The event that occurred.
-         * @param data The list of events from the window.
+         * @param pollEvent The events polled by the window.
          */
-        void updateObserver(std::string event, const std::vector<SDL_Event> &data) override;
+        void onPoll(const Core::WindowPollEvent &pollEvent);
 
     private:
         /**
@@ -538,6 +537,11 @@ namespace Input
          */
         Core::Window &window;
 
+        /**
+         * The id of the keyboard's WindowPollEvent listener.
+         */
+        Core::EventBus::ListenerId pollListenerId;
+
         /**
          * The state of each key.
          *
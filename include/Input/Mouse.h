@@ -1,7 +1,6 @@
 #pragma once
 
 #include "../Core/Window.h"
-#include "../Core/Observer.h"
 
 #include <glm/vec2.hpp>
 #include <vector>
@@ -40,7 +39,7 @@ namespace Input
     /**
      * Represents the mouse.
      */
-    class Mouse : public Core::Observer<const std::vector<SDL_Event> &>
+    class Mouse
     {
     public:
         /**
@@ -101,12 +100,11 @@ namespace Input
         /**
          * Update the mouse with new events.
          *
-         * This will be attached to the "poll" event of the window.
+         * This is subscribed to the WindowPollEvent of the window.
          *
-         * @param event The event that occurred.
-         * @param data The list of events from the window.
+         * @param pollEvent The events polled by the window.
          */
-        void updateObserver(std::string event, const std::vector<SDL_Event> &data) override;
+        void onPoll(const Core::WindowPollEvent &pollEvent);
 
     private:
         /**
@@ -114,6 +112,11 @@ namespace Input
          */
         Core::Window &window;
 
+        /**
+         * The id of the mouse's WindowPollEvent listener.
+         */
+        Core::EventBus::ListenerId pollListenerId;
+
         /**
          * The mouse position relative to the window.
          *
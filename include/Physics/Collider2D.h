@@ -38,9 +38,11 @@ namespace Physics
         /**
          * Creates a new 2D collider.
          *
+         * Takes the shape of the other collider instead of cloning it, the other collider is left without a shape.
+         *
          * @param other The 2D collider to move.
          */
-        Collider2D(const Collider2D &&other);
+        Collider2D(Collider2D &&other) noexcept;
 
         /**
          * Assigns the 2D collider.
@@ -52,9 +54,11 @@ namespace Physics
         /**
          * Assigns the 2D collider.
          *
+         * Takes the shape of the other collider instead of cloning it, the other collider is left without a shape.
+         *
          * @param other The 2D collider to move.
          */
-        Physics::Collider2D &operator=(const Physics::Collider2D &&other);
+        Physics::Collider2D &operator=(Physics::Collider2D &&other) noexcept;
 
         /**
          * Destroys the 2D collider.
@@ -273,6 +277,15 @@ namespace Physics
          */
         std::vector<b2Fixture *> *getFixtures();
 
+        /**
+         * Gets the underlying Box2D fixture.
+         *
+         * May be nullptr if the fixture has not been created yet.
+         *
+         * @returns The underlying Box2D fixtures.
+         */
+        const std::vector<b2Fixture *> *getFixtures() const;
+
         /**
          * Sets the underlying Box2D fixture.
          *
@@ -234,6 +234,31 @@ namespace Physics
          */
         std::unordered_map<ECS::Entity, std::unordered_map<JointType, b2Joint *>> joints;
 
+        /**
+         * The entities whose transform or rigid body has been added or removed since bodies were last updated.
+         *
+         * These are filled by the registry's component signals, see `ECS::Registry::getSignals`.
+         */
+        std::vector<ECS::Entity> pendingBodyEntities;
+
+        /**
+         * The registry the component signals are subscribed on, nullptr once it has been destroyed.
+         */
+        const ECS::Registry *signalRegistry = nullptr;
+
+        Core::EventBus::ListenerId transformConstructedListenerId;
+        Core::EventBus::ListenerId transformDestroyedListenerId;
+        Core::EventBus::ListenerId rigidBodyConstructedListenerId;
+        Core::EventBus::ListenerId rigidBodyDestroyedListenerId;
+        Core::EventBus::ListenerId registryDestroyedListenerId;
+
+        /**
+         * The registry's change tick after physics last wrote its values to the ECS.
+         *
+         * Only bodies whose world transform has changed since this tick have their transform injected into box2d.
+         */
+        uint64_t lastChangeTick = 0;
+
         /**
          * The contact listener for the world.
          */
@@ -263,7 +288,7 @@ namespace Physics
          * @param world The world to use.
          * @param entitySet The set of entities to create bodies for.
          */
-        void createBodies(const World::World &world, const std::unordered_set<ECS::Entity> &entitySet);
+        void createBodies(World::World &world, const std::unordered_set<ECS::Entity> &entitySet);
 
         /**
          * Destroys the given box2d body.
@@ -281,7 +306,7 @@ namespace Physics
          * @param world The world to use.
          * @param createdEntities The set of entities that were created this frame, these don't need updated.
          */
-        void updateBodiesWithECSValues(const World::World &world, const std::unordered_set<ECS::Entity> &createdEntities);
+        void updateBodiesWithECSValues(World::World &world, const std::unordered_set<ECS::Entity> &createdEntities);
 
         /**
          * Creates a Box2D collider for the entity.
@@ -289,7 +314,7 @@ namespace Physics
          * @param world The world to use.
          * @param entity The entity to create the collider for.
          */
-        void createBox2DCollider(const World::World &world, ECS::Entity entity);
+        void createBox2DCollider(World::World &world, ECS::Entity entity);
 
         /**
          * Destroys a Box2D collider for the entity.
@@ -301,11 +326,14 @@ namespace Physics
         void destroyBox2DCollider(ECS::Entity entity);
 
         /**
-         * Updates the Box2D world with the values from the ECS.
+         * Updates the ECS with the values from the Box2D world.
+         *
+         * Transforms changed during the step, e.g. by contact callbacks, are kept and injected into box2d instead of being overwritten.
          *
          * @param world The world to use.
+         * @param stepTick The change tick taken before the step.
          */
-        void updateECSWithBox2DValues(const World::World &world);
+        void updateECSWithBox2DValues(World::World &world, uint64_t stepTick);
 
         /**
          * Updates the joints for the world.
@@ -20,5 +20,5 @@ namespace Rendering
      *
      * @returns The material for the given entity.
      */
-    Material *getMaterial(const ECS::Registry &registry, ECS::Entity entity);
+    const Material *getMaterial(const ECS::Registry &registry, ECS::Entity entity);
 }
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include <unordered_map>
 #include <vector>
 
+#define BATCH_PASS_GRAIN_SIZE 2048
+
 namespace Rendering
 {
     /**
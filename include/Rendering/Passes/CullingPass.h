@@ -35,7 +35,7 @@ namespace Rendering
         /**
          * Destroys the CullingPass instance.
          */
-        virtual ~CullingPass() = default;
+        virtual ~CullingPass();
 
         /**
          * Executes the culling pass.
@@ -80,35 +80,53 @@ namespace Rendering
         Core::AABB getCullingAABB(World::World &world, const Core::SpaceTransformer &spaceTransformer, const ECS::Entity camera) const;
 
         /**
-         * The number of calls to getRenderables to wait before pruning the AABB tree.
-         *
-         * Pruning involves removing entities that are no longer in the registry.
+         * The threshold of entities in the tree to perform a merge.
          */
-        unsigned int treePruneFrequency = 1000;
+        size_t treeMergeThreshold = 1000;
 
         /**
-         * The number of calls to getRenderables since the last prune.
+         * The threshold of percantage of entities inserted into the tree that will trigger a merge.
          */
-        unsigned int callsSinceLastTreePrune = 0;
+        size_t treeMergeModifiedThreshold = 0.1;
 
         /**
-         * The threshold of entities in the tree to perform a merge.
+         * The registry's change tick when renderables were last culled.
+         *
+         * Dynamic renderables whose world transform and mesh haven't changed since this tick keep their AABB in the tree.
          */
-        size_t treeMergeThreshold = 1000;
+        uint64_t lastChangeTick = 0;
 
         /**
-         * The threshold of percantage of entities inserted into the tree that will trigger a merge.
+         * The registry the component signals are subscribed on, nullptr if there is none or it has been destroyed.
          */
-        size_t treeMergeModifiedThreshold = 0.1;
+        const ECS::Registry *signalRegistry = nullptr;
 
         /**
-         * Prunes the AABB trees.
+         * The entities whose Renderable component has been removed since the last execute, or which have been destroyed.
+         */
+        std::vector<ECS::Entity> destroyedRenderables;
+
+        Core::EventBus::ListenerId renderableDestroyedListenerId;
+        Core::EventBus::ListenerId registryDestroyedListenerId;
+
+        /**
+         * Subscribes to the component signals of the registry, so entities which are no longer renderable are removed from the trees.
          *
-         * This involves removing entities no longer have a Renderable component, or are no longer in the registry.
+         * @param registry The registry.
+         */
+        void subscribe(const ECS::Registry &registry);
+
+        /**
+         * Unsubscribes from the component signals of the registry, if subscribed and the registry still exists.
+         */
+        void unsubscribe();
+
+        /**
+         * Removes the entity from whichever AABB tree it is in.
          *
-         * @param registry The registry to prune against.
+         * @param entity The entity.
          */
-        void pruneTrees(const ECS::Registry &registry);
+        void removeFromTrees(ECS::Entity entity);
 
         /**
          * Static renderables and their previously computed aabbs.
@@ -137,8 +155,6 @@ namespace Rendering
         /**
          * Populates the renderables vector with all the entities that are inside the given aabb.
          *
-         * Also prunes the AABB trees, every `treePruneFrequency` calls.
-         *
          * The entities provided must have a `renderable.isStatic` that matches the `isStatic` parameter.
          *
          * @param world The world to use.
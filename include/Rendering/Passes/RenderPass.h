@@ -6,6 +6,7 @@
 #include "../RenderTarget.h"
 #include "../Texture/TextureManager.h"
 #include "../../Core/SpaceTransformer.h"
+#include "../../Core/JobSystem.h"
 
 #include <string>
 
@@ -46,6 +47,11 @@ namespace Rendering
          */
         Core::SpaceTransformer *spaceTransformer;
 
+        /**
+         * The job system to run parallel work on, or nullptr if passes should run on the calling thread.
+         */
+        Core::JobSystem *jobSystem;
+
         /**
          * Destroys the render pass input.
          */
@@ -104,6 +110,7 @@ namespace Rendering
             renderTarget = input->renderTarget;
             textureManager = input->textureManager;
             spaceTransformer = input->spaceTransformer;
+            jobSystem = input->jobSystem;
 
             this->data = data;
         }
@@ -14,6 +14,13 @@ namespace Rendering
 
         std::vector<ECS::Entity> dynamicRenderables;
         std::vector<ECS::Entity> newDynamicRenderables;
+
+        /**
+         * The entities that have stopped being renderable since the renderables were last fully rebuilt.
+         *
+         * Some of these may have become renderable again, in which case they will also be in the other lists.
+         */
+        std::vector<ECS::Entity> removedRenderables;
     };
 
     /**
@@ -62,6 +69,7 @@ namespace Rendering
         };
 
     private:
+        ECS::PersistentView view;
         uint64_t lastViewCacheTime = 0;
         std::vector<ECS::Entity> oldEntities;
         RenderablesPassData oldData;
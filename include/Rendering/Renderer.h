@@ -91,8 +91,6 @@ namespace Rendering
         /**
          * Updates the renderer.
          *
-         * This will prune the AABB trees every `treePruneFrequency` updates.
-         *
          * This will also update the active camera's size to match the renderer's size if `syncActiveCameraSizeWithRenderer` is true.
          *
          * This will also update the renderer's size to match the window size if `syncRendererSizeWithWindow` is true.
@@ -2,11 +2,13 @@
 
 #include "../ECS/Registry.h"
 #include "../ECS/Entity.h"
+#include "../ECS/Snapshot.h"
 #include "../Core/Transform.h"
 
 #include <glm/glm.hpp>
 #include <vector>
 #include <unordered_set>
+#include <span>
 
 namespace Scene
 {
@@ -27,7 +29,7 @@ namespace Scene
         /**
          * Creates a new scene graph.
          *
-         * @param registry The registry entities in the scene graph belong to.
+         * @param registry The registry entities in the scene graph belong to, it must outlive the scene graph.
          */
         SceneGraph(const ECS::Registry *registry);
 
@@ -66,6 +68,20 @@ namespace Scene
          */
         void relate(ECS::Entity parent, const std::vector<ECS::Entity> &children);
 
+        /**
+         * Creates a parent-child relationship between each pair of entities at the same index, i.e. `parents[i]` becomes the parent of `children[i]`.
+         *
+         * Every entity is checked before any relationship is created.
+         *
+         * Will also update the children's model matrices.
+         *
+         * @param parents The parent entities.
+         * @param children The child entities.
+         *
+         * @throws std::invalid_argument If the spans are different sizes, or any entity does not have a transform component.
+         */
+        void relate(std::span<const ECS::Entity> parents, std::span<const ECS::Entity> children);
+
         /**
          * Removes the parent-child relationship from the entity.
          *
@@ -152,19 +168,58 @@ namespace Scene
         void updateModelMatrix(ECS::Entity entity, bool updateParent = true, bool updateChildren = false) const;
 
         /**
-         * Updates the model matrices of all entities in the scene graph.
+         * Updates the model matrices of entities in the scene graph whose world transform has changed.
          *
-         * This will recalculate the model matrices of each entity in the scene graph.
+         * Only the subtrees of entities whose transform has changed since the last call are recalculated, see `ECS::Registry::changed`.
+         * Transforms written without being recorded as changed (e.g. through a reference kept from an earlier `get`) must be marked with `ECS::Registry::markChanged`.
          * 
          * Also removes entities from the scene graph that are not in the registry.
          */
         void updateModelMatrices();
 
         /**
-         * Removes entities from the scene graph that are not in the registry. 
-        */
+         * Removes entities from the scene graph that are not in the registry.
+         *
+         * Only the entities whose transform has been removed since the last call are checked, see `ECS::ComponentDestroyed`.
+         */
         void removeEntitiesNotInRegistry();
 
+        /**
+         * Returns whether or not the world transform of the given entity has changed since the given tick.
+         *
+         * This is the case if the transform of the entity or any of its ancestors has changed, or the entity has been related or unrelated.
+         *
+         * @param entity The entity to check.
+         * @param sinceTick The change tick to check for changes after, see `ECS::Registry::changed`.
+         *
+         * @returns Whether or not the world transform of the entity has changed.
+         */
+        bool hasWorldTransformChanged(ECS::Entity entity, uint64_t sinceTick) const;
+
+        /**
+         * Removes all parent-child relationships.
+         */
+        void clear();
+
+        /**
+         * Writes the parent-child relationships to a snapshot.
+         *
+         * @param writer The snapshot writer.
+         */
+        void writeSnapshot(ECS::SnapshotWriter &writer) const;
+
+        /**
+         * Replaces the parent-child relationships with ones written by `writeSnapshot`.
+         *
+         * Model matrices are recalculated when they are next needed.
+         *
+         * @param reader The snapshot reader.
+         *
+         * @throws std::runtime_error If the snapshot is truncated, relates an entity more than once or makes an entity its own ancestor.
+         * @throws std::invalid_argument If a related entity does not have a transform component.
+         */
+        void readSnapshot(ECS::SnapshotReader &reader);
+
     private:
         const ECS::Registry *registry;
 
@@ -184,5 +239,17 @@ namespace Scene
          * The world transforms of each entity.
          */
         mutable std::unordered_map<ECS::Entity, glm::mat4> modelMatrices;
+
+        /**
+         * The change tick of the last call to `updateModelMatrices`.
+         */
+        uint64_t lastChangeTick = 0;
+
+        /**
+         * The entities whose transform has been removed since the last call to `removeEntitiesNotInRegistry`.
+         */
+        std::vector<ECS::Entity> removedTransforms;
+
+        Core::EventBus::ListenerId transformDestroyedListenerId;
     };
 }
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+namespace remi
+{
+    /**
+     * A file mapped read only into memory.
+     *
+     * The file's pages are loaded by the operating system as they are read, so nothing is copied up front.
+     *
+     * A mapped file cannot be copied or moved.
+     */
+    class MappedFile
+    {
+    public:
+        /**
+         * Maps the file at the given path.
+         *
+         * @param path The path to the file.
+         *
+         * @throws std::runtime_error If the file cannot be opened or mapped.
+         */
+        MappedFile(const std::string &path);
+
+        /**
+         * Unmaps the file.
+         */
+        ~MappedFile();
+
+        MappedFile(const MappedFile &other) = delete;
+
+        MappedFile &operator=(const MappedFile &other) = delete;
+
+        /**
+         * Gets the contents of the file.
+         *
+         * @returns The contents of the file, nullptr if the file is empty.
+         */
+        const std::byte *getData() const;
+
+        /**
+         * Gets the size of the file.
+         *
+         * @returns The size of the file in bytes.
+         */
+        size_t getSize() const;
+
+    private:
+        const std::byte *data = nullptr;
+        size_t size = 0;
+
+#ifdef _WIN32
+        void *fileHandle = nullptr;
+        void *mappingHandle = nullptr;
+#endif
+    };
+}
\ No newline at end of file
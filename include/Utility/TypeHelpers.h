@@ -2,6 +2,7 @@
 
 #include <typeinfo>
 #include <string>
+#include <cstddef>
 
 namespace remi
 {
@@ -10,7 +11,9 @@ namespace remi
     /**
      * Generates a unique id for a type.
      *
-     * This function is memoized so it will only generate the id once per type.
+     * This function is memoized so it will only generate the id once per type. It is thread safe.
+     *
+     * The id is a hash of the type's name, so it is the same in every run, but two types may share an id.
      *
      * @param typeName The name of the type (use `typeid(T).name()`)
      *
@@ -18,6 +21,18 @@ namespace remi
      */
     TypeId generateTypeId(const char *typeName);
 
+    /**
+     * Generates a dense index for a type.
+     *
+     * Indices are handed out in the order types are first seen, starting at 0, so they can index a flat array.
+     * No two types share an index, but the index of a type can differ between runs. This function is thread safe.
+     *
+     * @param typeName The name of the type (use `typeid(T).name()`)
+     *
+     * @returns The type's index
+     */
+    size_t generateTypeIndex(const char *typeName);
+
     class TypeInfoGenerator
     {
     public:
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace ECS
+{
+    class System;
+}
+
+namespace World
+{
+    /**
+     * The timings of one update function of a system, i.e. `update` or `fixedUpdate`.
+     *
+     * Averages and maximums are over the last frames recorded, see `World::setSystemStatsFrames`.
+     * Times are wall times in milliseconds.
+     */
+    struct SystemTimings
+    {
+        /**
+         * The number of times the function has been called since the system was added or the stats were reset.
+         */
+        size_t calls = 0;
+
+        double lastTime = 0;
+        double averageTime = 0;
+        double maxTime = 0;
+
+        /**
+         * The number of entities the system reported touching, see `ECS::System::addTouchedEntities`.
+         */
+        size_t lastEntities = 0;
+        double averageEntities = 0;
+        size_t maxEntities = 0;
+    };
+
+    /**
+     * The timings of a system.
+     */
+    struct SystemStats
+    {
+        ECS::System *system;
+
+        SystemTimings update;
+        SystemTimings fixedUpdate;
+    };
+
+    /**
+     * Records the calls of one update function of a system, keeping the samples of the last frames in a ring buffer.
+     */
+    class SystemTimingRecorder
+    {
+    public:
+        /**
+         * Creates a recorder.
+         *
+         * @param frames The number of frames to average over, must be greater than 0.
+         *
+         * @throws std::invalid_argument If frames is 0.
+         */
+        SystemTimingRecorder(size_t frames);
+
+        /**
+         * Records a call, replacing the oldest sample once there are as many samples as frames.
+         *
+         * @param time The wall time of the call in milliseconds.
+         * @param entities The number of entities touched by the call.
+         */
+        void record(double time, size_t entities);
+
+        /**
+         * Gets the timings over the recorded samples.
+         *
+         * @returns The timings.
+         */
+        SystemTimings getTimings() const;
+
+    private:
+        struct Sample
+        {
+            double time;
+            size_t entities;
+        };
+
+        size_t frames;
+        size_t calls = 0;
+
+        /**
+         * The samples, at most `frames` of them, the sample at `next` is the oldest once there are that many.
+         */
+        std::vector<Sample> samples;
+        size_t next = 0;
+    };
+}
\ No newline at end of file
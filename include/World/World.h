@@ -1,9 +1,21 @@
 #pragma once
 
 #include "../ECS/Registry.h"
+#include "../ECS/CommandBuffer.h"
+#include "../ECS/Prefab.h"
 #include "../Scene/SceneGraph.h"
 #include "../Core/Timestep.h"
 #include "../ECS/System.h"
+#include "../Core/JobSystem.h"
+#include "../Utility/MappedFile.h"
+#include "SystemStats.h"
+
+#include <string>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+
+#define WORLD_DEFAULT_SYSTEM_STATS_FRAMES 60
 
 namespace World
 {
@@ -11,12 +23,17 @@ namespace World
     /**
      * Represents the world.
      *
-     * This contains the registry and scene graph.
+     * This contains the registry, scene graph and command buffer.
      *
      * The registry is used to store entities and their components.
      *
      * The scene graph is used to organize entities into a parent-child hierarchy.
      *
+     * Systems are run in the order they were added, except that systems whose declared component access does not conflict
+     * (see ECS::System) may be run at the same time on the world's job system.
+     *
+     * The wall time of every update of every system is recorded, see `getSystemStats`.
+     *
      * The world cannot be copied or moved.
      */
     class World
@@ -45,6 +62,8 @@ namespace World
         /**
          * Runs all updates.
          *
+         * Non conflicting systems are run in parallel if the world has a job system.
+         *
          * Does not run fixed updates.
          *
          * @param timestep The timestep since the last update.
@@ -54,6 +73,8 @@ namespace World
         /**
          * Runs all fixed updates.
          *
+         * Non conflicting systems are run in parallel if the world has a job system.
+         *
          * @param timestep The timestep since the last update.
          */
         void fixedUpdate(const ECS::System::SystemUpdateData &data);
@@ -94,6 +115,71 @@ namespace World
          */
         bool hasSystem(ECS::System *system);
 
+        /**
+         * Runs the fixed update of a system which is not added to the world, recording its stats like the world's own systems.
+         *
+         * This is for systems which must run at a fixed point outside of `fixedUpdate`, e.g. physics between command buffer sync points.
+         * The system is included in `getSystemStats`, after the world's systems, from its first run.
+         *
+         * @param system The system to run.
+         * @param data The system update data.
+         *
+         * @throws std::invalid_argument If the system is nullptr or has been added to the world.
+         */
+        void fixedUpdateUnscheduled(ECS::System *system, const ECS::System::SystemUpdateData &data);
+
+        /**
+         * Gets the timings of each system, in the order the systems were added.
+         *
+         * Systems run with `fixedUpdateUnscheduled` come after the added systems, in the order they were first run.
+         *
+         * Averages and maximums are over the last `getSystemStatsFrames` calls of each update function.
+         *
+         * @returns The stats of each system.
+         */
+        std::vector<SystemStats> getSystemStats() const;
+
+        /**
+         * Sets the number of frames system stats are averaged over.
+         *
+         * This resets the stats of all systems.
+         *
+         * @param frames The number of frames, defaults to WORLD_DEFAULT_SYSTEM_STATS_FRAMES (60).
+         *
+         * @throws std::invalid_argument If frames is 0.
+         */
+        void setSystemStatsFrames(size_t frames);
+
+        /**
+         * Gets the number of frames system stats are averaged over.
+         *
+         * @returns The number of frames.
+         */
+        size_t getSystemStatsFrames() const;
+
+        /**
+         * Resets the stats of all systems.
+         */
+        void resetSystemStats();
+
+        /**
+         * Sets the job system used to run systems in parallel.
+         *
+         * This is also set as the registry's job system, for `ECS::Registry::parallelEach`.
+         *
+         * The world does not take ownership of the job system.
+         *
+         * @param jobSystem The job system, or nullptr to run all systems on the calling thread.
+         */
+        void setJobSystem(Core::JobSystem *jobSystem);
+
+        /**
+         * Gets the job system used to run systems in parallel.
+         *
+         * @returns The job system, or nullptr if systems are run on the calling thread.
+         */
+        Core::JobSystem *getJobSystem();
+
         /**
          * Gets the registry.
          *
@@ -122,11 +208,178 @@ namespace World
          */
         const Scene::SceneGraph &getSceneGraph() const;
 
+        /**
+         * Gets the command buffer.
+         *
+         * Structural changes to the registry made while it may be iterated, i.e. from systems or contact callbacks, should be recorded here.
+         * The engine applies the buffer after fixed updates, after the physics step and after updates.
+         *
+         * @returns The command buffer.
+         */
+        ECS::CommandBuffer &getCommandBuffer();
+
+        /**
+         * Creates the given number of copies of a prefab and its children.
+         *
+         * Each copy of a child prefab is related to its copy of the parent in the scene graph.
+         * Every level of the hierarchy is instantiated in one batch, see `ECS::Registry::instantiate`.
+         *
+         * @param prefab The prefab.
+         * @param count The number of copies to create.
+         * @param init Called with each top level entity and its index once the whole hierarchy has been created, can be nullptr.
+         *
+         * @returns The new top level entities.
+         *
+         * @throws std::invalid_argument If the prefab has children but it or any of its children does not have a transform component.
+         * @throws std::runtime_error If there are not enough entity ids available.
+         */
+        std::vector<ECS::Entity> instantiate(const ECS::Prefab &prefab, size_t count, const std::function<void(ECS::Entity, size_t)> &init = nullptr);
+
+        /**
+         * Saves the entities, the given components and the scene graph to a snapshot file.
+         *
+         * Components of other types are not saved. The scene graph relates entities by their transform,
+         * so it is only saved if `Core::Transform` is one of the types.
+         *
+         * The snapshot is in the native byte order and layout, so it can only be loaded by a build for the same platform.
+         *
+         * @tparam Types The types of components to save, must be trivially copyable.
+         *
+         * @param path The path of the file to write.
+         *
+         * @throws std::runtime_error If the file cannot be written.
+         */
+        template <typename... Types>
+        void saveSnapshot(const std::string &path) const
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                throw std::runtime_error("World (saveSnapshot): Failed to open file '" + path + "'.");
+            }
+
+            ECS::SnapshotWriter writer(file);
+            writer.writeHeader();
+
+            registry.writeSnapshot<Types...>(writer);
+
+            // relations need the transforms of the related entities, so they are only saved with them
+            if constexpr ((std::is_same_v<Types, Core::Transform> || ...))
+            {
+                sceneGraph.writeSnapshot(writer);
+            }
+            else
+            {
+                // no relations, as an empty scene graph would write
+                writer.write<uint64_t>(0);
+            }
+        }
+
+        /**
+         * Replaces the entities, components and scene graph with a snapshot file written by `saveSnapshot`.
+         *
+         * The file is memory mapped and each component pool is filled in bulk straight from it,
+         * which is much faster than creating the entities and adding their components one by one.
+         *
+         * Commands in the command buffer are discarded.
+         *
+         * @tparam Types The types of components in the snapshot, may include types which are not in it.
+         *
+         * @param path The path of the file to load.
+         *
+         * @throws std::runtime_error If the file cannot be read or is not a snapshot, in which case the world is unchanged.
+         *                            If the snapshot is invalid, in which case the world is left empty.
+         */
+        template <typename... Types>
+        void loadSnapshot(const std::string &path)
+        {
+            remi::MappedFile file(path);
+
+            ECS::SnapshotReader reader(file.getData(), file.getSize());
+            reader.readHeader();
+
+            commandBuffer.clear();
+
+            try
+            {
+                registry.readSnapshot<Types...>(reader);
+                sceneGraph.readSnapshot(reader);
+            }
+            catch (...)
+            {
+                registry.destroyAll();
+                throw;
+            }
+        }
+
     private:
         ECS::Registry registry;
         Scene::SceneGraph sceneGraph;
+        ECS::CommandBuffer commandBuffer;
 
         std::unordered_set<ECS::System *> systemsSet;
         std::vector<ECS::System *> systems;
+
+        /**
+         * The systems run with `fixedUpdateUnscheduled`, kept so their stats can be listed.
+         */
+        std::vector<ECS::System *> unscheduledSystems;
+
+        Core::JobSystem *jobSystem = nullptr;
+
+        struct SystemRecorders
+        {
+            SystemTimingRecorder update;
+            SystemTimingRecorder fixedUpdate;
+        };
+
+        /**
+         * The stats recorders of each system.
+         *
+         * The map is only changed when systems are added or removed, so systems running in parallel can each find and write their own recorders.
+         */
+        std::unordered_map<ECS::System *, SystemRecorders> systemRecorders;
+        size_t systemStatsFrames = WORLD_DEFAULT_SYSTEM_STATS_FRAMES;
+
+        /**
+         * The systems grouped into stages.
+         *
+         * The systems in a stage do not conflict with each other and can be run at the same time.
+         * Each stage only runs after all previous stages have finished.
+         */
+        std::vector<std::vector<ECS::System *>> stages;
+        bool stagesDirty = true;
+
+        /**
+         * Groups the systems into stages.
+         *
+         * A system is placed in the stage after the last stage containing a system, added before it, that it conflicts with.
+         */
+        void buildStages();
+
+        /**
+         * Instantiates the children of a prefab for each of the given instances of the prefab, recursively.
+         *
+         * @param prefab The prefab.
+         * @param parents The instances of the prefab.
+         */
+        void instantiateChildren(const ECS::Prefab &prefab, const std::vector<ECS::Entity> &parents);
+
+        /**
+         * Runs the given update function of every system, stage by stage.
+         *
+         * @param update The update function to run, i.e. `&ECS::System::update`.
+         * @param data The system update data.
+         */
+        void runSystems(void (ECS::System::*update)(const ECS::System::SystemUpdateData &), const ECS::System::SystemUpdateData &data);
+
+        /**
+         * Runs an update function of a system and records its time and the entities it touched.
+         *
+         * @param system The system.
+         * @param update The update function to run.
+         * @param data The system update data.
+         */
+        void runSystem(ECS::System *system, void (ECS::System::*update)(const ECS::System::SystemUpdateData &), const ECS::System::SystemUpdateData &data);
     };
 }
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include "../../include/Core/EventBus.h"
+
+#include <mutex>
+#include <unordered_map>
+
+Core::EventId Core::internEvent(const std::string &name)
+{
+    static std::unordered_map<std::string, EventId> eventIds;
+    static std::mutex eventIdsMutex;
+
+    std::lock_guard<std::mutex> lock(eventIdsMutex);
+
+    // emplace only inserts if the name has not been seen, so the next id is the number of names seen so far
+    return eventIds.emplace(name, eventIds.size()).first->second;
+}
+
+void Core::EventBus::flush()
+{
+    // swap the list out, so channels queued by listeners during the flush are delivered next time
+    flushingChannels.swap(queuedChannels);
+
+    for (auto eventId : flushingChannels)
+    {
+        channels[eventId]->flush();
+    }
+
+    flushingChannels.clear();
+}
+
+void Core::EventBus::clearQueue()
+{
+    for (auto eventId : queuedChannels)
+    {
+        channels[eventId]->clearQueue();
+    }
+
+    queuedChannels.clear();
+}
+
+size_t Core::EventBus::getQueuedCount() const
+{
+    size_t count = 0;
+
+    for (auto eventId : queuedChannels)
+    {
+        count += channels[eventId]->getQueuedCount();
+    }
+
+    return count;
+}
\ No newline at end of file
@@ -0,0 +1,312 @@
+#include "../../include/Core/JobSystem.h"
+
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+namespace
+{
+    /**
+     * The job system the calling thread is a worker of.
+     */
+    thread_local const Core::JobSystem *currentJobSystem = nullptr;
+
+    /**
+     * The index of the calling thread's worker queue in `currentJobSystem`.
+     */
+    thread_local long long currentWorkerIndex = -1;
+}
+
+Core::JobSystem::JobSystem(unsigned int workerCount, bool pinWorkers)
+{
+    queues.reserve(workerCount);
+    workers.reserve(workerCount);
+
+    // all queues must exist before any worker starts stealing
+    for (unsigned int i = 0; i < workerCount; i++)
+    {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    for (unsigned int i = 0; i < workerCount; i++)
+    {
+        workers.emplace_back([this, i, pinWorkers]()
+                             {
+                                 if (pinWorkers)
+                                 {
+                                     pinCurrentThread(i + 1);
+                                 }
+
+                                 workerLoop(i); });
+    }
+}
+
+Core::JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+
+    wake.notify_all();
+
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void Core::JobSystem::submit(std::function<void()> job, Counter &counter)
+{
+    counter.unfinishedJobs.fetch_add(1, std::memory_order_relaxed);
+
+    enqueue(Job{std::move(job), &counter});
+}
+
+void Core::JobSystem::submitAfter(Counter &dependency, std::function<void()> job, Counter &counter)
+{
+    counter.unfinishedJobs.fetch_add(1, std::memory_order_relaxed);
+
+    {
+        // the last job of the dependency takes the continuations while holding the mutex,
+        // so if it hasn't finished yet it will see this continuation
+        std::lock_guard<std::mutex> lock(dependency.mutex);
+
+        if (!dependency.isDone())
+        {
+            dependency.continuations.emplace_back(std::move(job), &counter);
+            return;
+        }
+    }
+
+    enqueue(Job{std::move(job), &counter});
+}
+
+void Core::JobSystem::wait(Counter &counter)
+{
+    while (!counter.isDone())
+    {
+        Job job;
+        if (takeJob(job))
+        {
+            runJob(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this, &counter]
+                  { return counter.isDone() || queuedJobs.load(std::memory_order_acquire) > 0; });
+    }
+
+    // the last job holds the mutex while finishing the counter, so wait for it to let go before the counter can be destroyed
+    std::lock_guard<std::mutex> lock(counter.mutex);
+
+    if (counter.exception != nullptr)
+    {
+        auto e = counter.exception;
+        counter.exception = nullptr;
+
+        std::rethrow_exception(e);
+    }
+}
+
+unsigned int Core::JobSystem::getWorkerCount() const
+{
+    return workers.size();
+}
+
+unsigned int Core::JobSystem::getDefaultWorkerCount()
+{
+#ifdef __EMSCRIPTEN__
+    return 0;
+#else
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+#endif
+}
+
+void Core::JobSystem::workerLoop(size_t index)
+{
+    currentJobSystem = this;
+    currentWorkerIndex = index;
+
+    while (true)
+    {
+        Job job;
+        if (takeJob(job))
+        {
+            runJob(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this]
+                  { return stopping || queuedJobs.load(std::memory_order_acquire) > 0; });
+
+        if (stopping && queuedJobs.load(std::memory_order_acquire) == 0)
+        {
+            return;
+        }
+    }
+}
+
+bool Core::JobSystem::takeJob(Job &job)
+{
+    if (queuedJobs.load(std::memory_order_acquire) == 0)
+    {
+        return false;
+    }
+
+    long long index = getCurrentWorkerIndex();
+
+    // newest job from our own queue, it is most likely to still be in the cache
+    if (index != -1)
+    {
+        auto &queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (!queue.jobs.empty())
+        {
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+
+            return true;
+        }
+    }
+
+    // otherwise steal the oldest job from another queue
+    size_t start = index == -1 ? 0 : index + 1;
+
+    for (size_t i = 0; i < queues.size(); i++)
+    {
+        auto &queue = *queues[(start + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (!queue.jobs.empty())
+        {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Core::JobSystem::runJob(Job &job)
+{
+    std::exception_ptr exception = nullptr;
+
+    try
+    {
+        job.func();
+    }
+    catch (...)
+    {
+        exception = std::current_exception();
+    }
+
+    auto &counter = *job.counter;
+    std::vector<std::pair<std::function<void()>, Counter *>> continuations;
+    bool finished = false;
+
+    {
+        std::lock_guard<std::mutex> lock(counter.mutex);
+
+        if (exception != nullptr && counter.exception == nullptr)
+        {
+            counter.exception = exception;
+        }
+
+        if (counter.unfinishedJobs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            finished = true;
+            continuations.swap(counter.continuations);
+        }
+    }
+
+    // the counter may be destroyed from here on
+
+    if (!finished)
+    {
+        return;
+    }
+
+    for (auto &continuation : continuations)
+    {
+        enqueue(Job{std::move(continuation.first), continuation.second});
+    }
+
+    // wake any threads waiting on the counter
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+
+    wake.notify_all();
+}
+
+void Core::JobSystem::enqueue(Job job)
+{
+    if (workers.empty())
+    {
+        runJob(job);
+        return;
+    }
+
+    long long index = getCurrentWorkerIndex();
+    if (index == -1)
+    {
+        index = nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    }
+
+    {
+        auto &queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        queue.jobs.push_back(std::move(job));
+    }
+
+    queuedJobs.fetch_add(1, std::memory_order_release);
+
+    {
+        // lock so a thread about to sleep can't miss the notification
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+
+    wake.notify_one();
+}
+
+long long Core::JobSystem::getCurrentWorkerIndex() const
+{
+    return currentJobSystem == this ? currentWorkerIndex : -1;
+}
+
+void Core::JobSystem::pinCurrentThread(unsigned int core)
+{
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+
+    if (hardwareThreads == 0)
+    {
+        return;
+    }
+
+    core %= hardwareThreads;
+
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(core, &cpuSet);
+
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+#elif defined(_WIN32)
+    SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << core);
+#endif
+}
\ No newline at end of file
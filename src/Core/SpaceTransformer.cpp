@@ -45,7 +45,7 @@ glm::vec2 Core::SpaceTransformer::transform(const glm::vec2 &v, const ECS::Entit
 float Core::SpaceTransformer::transformLocalRotationToWorld(float rotation, const ECS::Entity entity) const
 {
     auto &sceneGraph = world->getSceneGraph();
-    auto &registry = world->getRegistry();
+    const auto &registry = world->getRegistry();
 
     if (!sceneGraph.hasParent(entity))
     {
@@ -64,7 +64,7 @@ float Core::SpaceTransformer::transformLocalRotationToWorld(float rotation, cons
 float Core::SpaceTransformer::transformWorldRotationToLocal(float rotation, const ECS::Entity entity) const
 {
     auto &sceneGraph = world->getSceneGraph();
-    auto &registry = world->getRegistry();
+    const auto &registry = world->getRegistry();
 
     if (!sceneGraph.hasParent(entity))
     {
@@ -196,7 +196,7 @@ Core::SpaceTransformer::Space Core::SpaceTransformer::clipToScreen(glm::vec2 &v)
 Core::SpaceTransformer::Space Core::SpaceTransformer::clipToView(glm::vec2 &v) const
 {
 
-    auto &registry = world->getRegistry();
+    const auto &registry = world->getRegistry();
     auto &sceneGraph = world->getSceneGraph();
 
     auto camera = renderer->getActiveCamera(registry);
@@ -218,7 +218,7 @@ Core::SpaceTransformer::Space Core::SpaceTransformer::clipToView(glm::vec2 &v) c
 
 Core::SpaceTransformer::Space Core::SpaceTransformer::viewToClip(glm::vec2 &v) const
 {
-    auto &registry = world->getRegistry();
+    const auto &registry = world->getRegistry();
     auto &sceneGraph = world->getSceneGraph();
 
     auto camera = renderer->getActiveCamera(registry);
@@ -237,7 +237,7 @@ Core::SpaceTransformer::Space Core::SpaceTransformer::viewToClip(glm::vec2 &v) c
 
 Core::SpaceTransformer::Space Core::SpaceTransformer::viewToWorld(glm::vec2 &v) const
 {
-    auto &registry = world->getRegistry();
+    const auto &registry = world->getRegistry();
     auto &sceneGraph = world->getSceneGraph();
 
     auto camera = renderer->getActiveCamera(registry);
@@ -259,7 +259,7 @@ Core::SpaceTransformer::Space Core::SpaceTransformer::viewToWorld(glm::vec2 &v)
 
 Core::SpaceTransformer::Space Core::SpaceTransformer::worldToView(glm::vec2 &v) const
 {
-    auto &registry = world->getRegistry();
+    const auto &registry = world->getRegistry();
     auto &sceneGraph = world->getSceneGraph();
 
     auto camera = renderer->getActiveCamera(registry);
@@ -59,7 +59,10 @@ const std::vector<SDL_Event> &Core::Window::pollEvents()
         event = SDL_Event();
     }
 
-    notifyObservers(Core::WindowPollEventName, events);
+    // polling ends the frame, so deliver the events queued during it first
+    eventBus.flush();
+
+    eventBus.publish(Core::WindowPollEvent{events});
 
     return events;
 }
@@ -69,6 +72,11 @@ const std::vector<SDL_Event> &Core::Window::getEvents() const
     return events;
 }
 
+Core::EventBus &Core::Window::getEventBus()
+{
+    return eventBus;
+}
+
 void Core::Window::show()
 {
     showWindow = true;
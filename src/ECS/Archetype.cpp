@@ -0,0 +1,94 @@
+#include "../../include/ECS/Archetype.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+ECS::Archetype::Archetype(std::vector<ComponentId> signature) : signature(std::move(signature)), mask(this->signature)
+{
+}
+
+ECS::Archetype::~Archetype()
+{
+}
+
+size_t ECS::Archetype::add(Entity entity)
+{
+    entities.push_back(entity);
+
+    return entities.size() - 1;
+}
+
+bool ECS::Archetype::remove(size_t row)
+{
+    if (row >= entities.size())
+    {
+        throw std::runtime_error("Archetype (remove): Row '" + std::to_string(row) + "' is out of range.");
+    }
+
+    size_t lastRow = entities.size() - 1;
+    bool swapped = row != lastRow;
+
+    if (swapped)
+    {
+        entities[row] = entities[lastRow];
+    }
+
+    entities.pop_back();
+
+    return swapped;
+}
+
+void ECS::Archetype::clear()
+{
+    entities.clear();
+}
+
+bool ECS::Archetype::hasAll(const std::vector<ComponentId> &componentIds) const
+{
+    return std::includes(signature.begin(), signature.end(), componentIds.begin(), componentIds.end());
+}
+
+const std::vector<ECS::ComponentId> &ECS::Archetype::getSignature() const
+{
+    return signature;
+}
+
+const ECS::ComponentMask &ECS::Archetype::getMask() const
+{
+    return mask;
+}
+
+const std::vector<ECS::Entity> &ECS::Archetype::getEntities() const
+{
+    return entities;
+}
+
+size_t ECS::Archetype::size() const
+{
+    return entities.size();
+}
+
+ECS::Archetype *ECS::Archetype::getAddEdge(ComponentId componentId) const
+{
+    auto it = addEdges.find(componentId);
+
+    return it != addEdges.end() ? it->second : nullptr;
+}
+
+void ECS::Archetype::setAddEdge(ComponentId componentId, Archetype *archetype)
+{
+    addEdges[componentId] = archetype;
+}
+
+ECS::Archetype *ECS::Archetype::getRemoveEdge(ComponentId componentId) const
+{
+    auto it = removeEdges.find(componentId);
+
+    return it != removeEdges.end() ? it->second : nullptr;
+}
+
+void ECS::Archetype::setRemoveEdge(ComponentId componentId, Archetype *archetype)
+{
+    removeEdges[componentId] = archetype;
+}
\ No newline at end of file
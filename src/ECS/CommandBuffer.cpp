@@ -0,0 +1,130 @@
+#include "../../include/ECS/CommandBuffer.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+ECS::CommandBuffer::CommandBuffer(Registry *registry) : registry(registry)
+{
+}
+
+ECS::CommandBuffer::~CommandBuffer()
+{
+    clear();
+}
+
+ECS::Entity ECS::CommandBuffer::create()
+{
+    auto entity = registry->reserve();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    created.push_back(entity);
+
+    return entity;
+}
+
+void ECS::CommandBuffer::destroy(Entity entity)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    destroyed.push_back(entity);
+}
+
+void ECS::CommandBuffer::apply()
+{
+    std::vector<Entity> created;
+    std::vector<Entity> destroyed;
+    std::vector<Command> commands;
+
+    // take the commands, so commands recorded while applying are kept for the next apply
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        created.swap(this->created);
+        destroyed.swap(this->destroyed);
+        commands.swap(this->commands);
+    }
+
+    if (created.empty() && destroyed.empty() && commands.empty())
+    {
+        return;
+    }
+
+    std::unordered_set<Entity> destroyedSet(destroyed.begin(), destroyed.end());
+
+    for (auto entity : created)
+    {
+        // created and destroyed in the same batch, so the entity never needs to exist
+        if (destroyedSet.contains(entity))
+        {
+            destroyedSet.erase(entity);
+            registry->releaseReserved(entity);
+
+            continue;
+        }
+
+        registry->createReserved(entity);
+    }
+
+    // group commands by component and then entity, stable so the commands for a component of an entity stay in the order they were recorded
+    std::stable_sort(commands.begin(), commands.end(), [](const Command &a, const Command &b)
+                     { return a.componentId != b.componentId ? a.componentId < b.componentId : a.entity < b.entity; });
+
+    for (size_t i = 0; i < commands.size(); i++)
+    {
+        auto &command = commands[i];
+
+        // only the last command for a component of an entity has an effect
+        if (i + 1 < commands.size() && commands[i + 1].componentId == command.componentId && commands[i + 1].entity == command.entity)
+        {
+            continue;
+        }
+
+        if (destroyedSet.contains(command.entity) || !registry->has(command.entity))
+        {
+            continue;
+        }
+
+        command.apply(*registry, command.entity);
+    }
+
+    std::vector<Entity> toDestroy;
+    toDestroy.reserve(destroyedSet.size());
+
+    for (auto entity : destroyedSet)
+    {
+        if (registry->has(entity))
+        {
+            toDestroy.push_back(entity);
+        }
+    }
+
+    std::sort(toDestroy.begin(), toDestroy.end());
+
+    registry->destroy(toDestroy);
+}
+
+void ECS::CommandBuffer::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto entity : created)
+    {
+        registry->releaseReserved(entity);
+    }
+
+    created.clear();
+    destroyed.clear();
+    commands.clear();
+}
+
+bool ECS::CommandBuffer::empty()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return created.empty() && destroyed.empty() && commands.empty();
+}
+
+void ECS::CommandBuffer::record(Entity entity, ComponentId componentId, std::function<void(Registry &, Entity)> apply)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    commands.push_back(Command{entity, componentId, std::move(apply)});
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "../../include/ECS/Prefab.h"
+
+ECS::Prefab::Prefab()
+{
+}
+
+ECS::Prefab::~Prefab()
+{
+    clearComponents();
+}
+
+ECS::Prefab::Prefab(const Prefab &other) : signature(other.signature), children(other.children)
+{
+    components.reserve(other.components.size());
+
+    for (auto component : other.components)
+    {
+        components.push_back(component->clone());
+    }
+}
+
+ECS::Prefab &ECS::Prefab::operator=(const Prefab &other)
+{
+    if (this == &other)
+    {
+        return *this;
+    }
+
+    clearComponents();
+
+    for (auto component : other.components)
+    {
+        components.push_back(component->clone());
+    }
+
+    signature = other.signature;
+    children = other.children;
+
+    return *this;
+}
+
+ECS::Prefab &ECS::Prefab::addChild(const Prefab &child)
+{
+    children.push_back(child);
+
+    return *this;
+}
+
+const std::vector<ECS::Prefab> &ECS::Prefab::getChildren() const
+{
+    return children;
+}
+
+const std::vector<ECS::ComponentId> &ECS::Prefab::getSignature() const
+{
+    return signature;
+}
+
+std::vector<ECS::Prefab::PrefabComponentBase *>::iterator ECS::Prefab::findComponent(ComponentId componentId)
+{
+    return std::lower_bound(components.begin(), components.end(), componentId, [](const PrefabComponentBase *component, ComponentId id)
+                            { return component->componentId < id; });
+}
+
+void ECS::Prefab::clearComponents()
+{
+    for (auto component : components)
+    {
+        delete component;
+    }
+
+    components.clear();
+}
\ No newline at end of file
@@ -1,95 +1,352 @@
 #include "../../include/ECS/Registry.h"
+#include "../../include/ECS/Prefab.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
 
 ECS::Registry::Registry(size_t maxEntities) : maxEntities(maxEntities)
 {
-    // create entity ids
-    for (Entity entity = 0; entity < maxEntities; entity++)
+    if (maxEntities == 0)
+    {
+        throw std::invalid_argument("Registry (Registry): Max entities must be greater than 0.");
+    }
+
+    // component pools are sparse sets indexed by entity index, checked here so the first add does not throw instead
+    if (maxEntities > ECS_SPARSE_SET_MAX_ID + size_t(1))
     {
-        freeEntityIds.push(entity);
+        throw std::invalid_argument("Registry (Registry): Max entities is greater than " + std::to_string(ECS_SPARSE_SET_MAX_ID + size_t(1)) + ".");
     }
+
+    if (maxEntities > MAX_ENTITY_INDICES)
+    {
+        throw std::invalid_argument("Registry (Registry): Max entities is greater than " + std::to_string(MAX_ENTITY_INDICES) + ".");
+    }
+
+    emptyArchetype = getArchetype({});
 }
 
 ECS::Registry::~Registry()
 {
-    for (auto &pair : componentPools)
+    signals.publish(RegistryDestroyed{this});
+
+    for (auto componentPool : componentPools)
+    {
+        delete componentPool;
+    }
+
+    for (auto archetype : archetypes)
+    {
+        delete archetype;
+    }
+
+    for (auto &pair : cachedViews)
     {
         delete pair.second;
     }
+
+    for (auto group : groups)
+    {
+        delete group;
+    }
 }
 
 ECS::Entity ECS::Registry::create()
 {
-    if (freeEntityIds.empty())
+    checkStructuralChange("create");
+
+    Entity entity;
+
     {
-        throw std::runtime_error("Registry (create): no more entity ids available.");
-    }
+        std::lock_guard<std::mutex> lock(freeEntityIdsMutex);
 
-    auto entity = freeEntityIds.front();
-    freeEntityIds.pop();
+        if (availableEntityIds() == 0)
+        {
+            throw std::runtime_error("Registry (create): no more entity ids available.");
+        }
 
-    entities.push_back(entity);
-    entitiesSet.insert(entity);
+        entity = takeEntityId();
+    }
+
+    addEntity(entity);
 
     return entity;
 }
 
+std::vector<ECS::Entity> ECS::Registry::create(size_t count)
+{
+    checkStructuralChange("create");
+
+    std::vector<Entity> created;
+    created.reserve(count);
+
+    {
+        std::lock_guard<std::mutex> lock(freeEntityIdsMutex);
+
+        if (availableEntityIds() < count)
+        {
+            throw std::runtime_error("Registry (create): not enough entity ids available to create " + std::to_string(count) + " entities.");
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            created.push_back(takeEntityId());
+        }
+    }
+
+    entities.reserve(entities.size() + count);
+
+    for (auto entity : created)
+    {
+        addEntity(entity);
+    }
+
+    return created;
+}
+
+std::vector<ECS::Entity> ECS::Registry::instantiate(const Prefab &prefab, size_t count, const std::function<void(Entity, size_t)> &init)
+{
+    checkStructuralChange("instantiate");
+
+    auto created = create(count);
+
+    if (count == 0)
+    {
+        return created;
+    }
+
+    for (auto component : prefab.components)
+    {
+        component->addTo(*this, created);
+    }
+
+    // move the entities straight to the prefab's archetype instead of through one archetype per component
+    auto archetype = getArchetype(prefab.getSignature());
+
+    if (archetype != emptyArchetype)
+    {
+        for (auto entity : created)
+        {
+            setArchetype(entity, archetype);
+        }
+
+        for (auto &[components, view] : cachedViews)
+        {
+            // views of no components are not kept up to date by add either
+            if (components.empty() || !archetype->hasAll(view->mask))
+            {
+                continue;
+            }
+
+            for (auto entity : created)
+            {
+                addToCachedView(*view, entity);
+            }
+        }
+
+        for (auto group : groups)
+        {
+            if (!archetype->hasAll(group->mask))
+            {
+                continue;
+            }
+
+            for (auto entity : created)
+            {
+                addToGroup(*group, entity);
+            }
+        }
+
+        publishConstructedSignals(*archetype, created);
+    }
+
+    if (init != nullptr)
+    {
+        for (size_t i = 0; i < created.size(); i++)
+        {
+            init(created[i], i);
+        }
+    }
+
+    return created;
+}
+
+ECS::Entity ECS::Registry::reserve()
+{
+    std::lock_guard<std::mutex> lock(freeEntityIdsMutex);
+
+    if (availableEntityIds() == 0)
+    {
+        throw std::runtime_error("Registry (reserve): no more entity ids available.");
+    }
+
+    return takeEntityId();
+}
+
+void ECS::Registry::createReserved(Entity entity)
+{
+    checkStructuralChange("createReserved");
+
+    if (has(entity))
+    {
+        throw std::runtime_error("Registry (createReserved): entity already exists.");
+    }
+
+    addEntity(entity);
+}
+
+void ECS::Registry::releaseReserved(Entity entity)
+{
+    if (has(entity))
+    {
+        throw std::runtime_error("Registry (releaseReserved): entity exists.");
+    }
+
+    std::lock_guard<std::mutex> lock(freeEntityIdsMutex);
+    freeEntityIds.push_back(entity);
+}
+
 void ECS::Registry::destroy(Entity entity)
 {
+    checkStructuralChange("destroy");
+
     if (!has(entity))
     {
         throw std::runtime_error("Registry (destroy): entity does not exist.");
     }
 
-    // remove entity from entities vector
-    for (auto it = entities.begin(); it != entities.end(); it++)
+    removeEntity(entity);
+}
+
+void ECS::Registry::destroy(std::span<const Entity> entities)
+{
+    checkStructuralChange("destroy");
+
+    for (auto entity : entities)
     {
-        if (*it == entity)
+        if (!has(entity))
         {
-            entities.erase(it);
-            break;
+            throw std::runtime_error("Registry (destroy): entity does not exist.");
         }
     }
 
-    // remove entity from entities set
-    entitiesSet.erase(entity);
+    // group the batch by archetype, so signals are published and cached views are checked once per archetype
+    // entity may be in the span more than once, so duplicates are dropped
+    std::vector<Entity> batch(entities.begin(), entities.end());
+
+    std::sort(batch.begin(), batch.end(), [this](Entity a, Entity b)
+              {
+                  auto archetypeA = getLocation(a).archetype;
+                  auto archetypeB = getLocation(b).archetype;
+
+                  return archetypeA != archetypeB ? std::less<Archetype *>()(archetypeA, archetypeB) : a < b; });
+
+    batch.erase(std::unique(batch.begin(), batch.end()), batch.end());
+
+    // the spans of entities which share an archetype
+    std::vector<std::span<const Entity>> runs;
 
-    // remove entity and its components from component pools
-    for (auto &pair : componentPools)
+    for (size_t begin = 0, end = 0; begin < batch.size(); begin = end)
     {
-        if (pair.second->has(entity))
+        auto archetype = getLocation(batch[begin]).archetype;
+
+        while (end < batch.size() && getLocation(batch[end]).archetype == archetype)
         {
-            pair.second->remove(entity);
-            invalidateCachedViews(pair.first);
+            end++;
         }
+
+        runs.emplace_back(batch.data() + begin, end - begin);
     }
 
-    freeEntityIds.push(entity);
-}
+    // every signal is published before anything is removed, so if a listener throws no entities are destroyed
+    for (auto run : runs)
+    {
+        publishDestroyedSignals(*getLocation(run.front()).archetype, run);
+    }
 
-void ECS::Registry::destroy(const std::vector<Entity> &entities)
-{
-    for (auto &entity : entities)
+    for (auto run : runs)
+    {
+        auto archetype = getLocation(run.front()).archetype;
+
+        // the entities can only be in the views whose components they have
+        for (auto &[components, view] : cachedViews)
+        {
+            if (archetype->hasAll(view->mask))
+            {
+                for (auto entity : run)
+                {
+                    removeFromCachedView(*view, entity);
+                }
+            }
+        }
+
+        for (auto entity : run)
+        {
+            eraseEntity(entity);
+        }
+    }
+
+    // the next entity in each slot gets the next generation, so handles to the destroyed entities stay invalid
+    std::lock_guard<std::mutex> lock(freeEntityIdsMutex);
+
+    for (auto entity : batch)
     {
-        destroy(entity);
+        freeEntityIds.push_back(makeEntity(entityIndex(entity), entityGeneration(entity) + 1));
     }
 }
 
 void ECS::Registry::destroyAll()
 {
-    entities.clear();
-    entitiesSet.clear();
+    checkStructuralChange("destroyAll");
 
-    for (auto &pair : componentPools)
+    for (auto archetype : archetypes)
     {
-        delete pair.second;
+        publishDestroyedSignals(*archetype, archetype->getEntities());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(freeEntityIdsMutex);
+
+        for (auto entity : entities)
+        {
+            freeEntityIds.push_back(makeEntity(entityIndex(entity), entityGeneration(entity) + 1));
+        }
     }
 
-    componentPools.clear();
+    clearEntities();
 }
 
 bool ECS::Registry::has(Entity entity) const
 {
-    return entitiesSet.contains(entity);
+    auto index = entityIndex(entity);
+
+    // the slot holds the entity's handle while it exists, a destroyed or reused slot holds a different one
+    return index < entityLocations.size() && entityLocations[index].entity == entity;
+}
+
+void ECS::Registry::setJobSystem(Core::JobSystem *jobSystem)
+{
+    this->jobSystem = jobSystem;
+}
+
+Core::JobSystem *ECS::Registry::getJobSystem() const
+{
+    return jobSystem;
+}
+
+Core::EventBus &ECS::Registry::getSignals() const
+{
+    return signals;
+}
+
+uint64_t ECS::Registry::getChangeTick() const
+{
+    return changeTick.load(std::memory_order_relaxed);
+}
+
+uint64_t ECS::Registry::advanceChangeTick() const
+{
+    return changeTick.fetch_add(1, std::memory_order_relaxed);
 }
 
 const std::vector<ECS::Entity> &ECS::Registry::getEntities() const
@@ -100,4 +357,730 @@ const std::vector<ECS::Entity> &ECS::Registry::getEntities() const
 size_t ECS::Registry::size() const
 {
     return entities.size();
+}
+
+size_t ECS::Registry::availableEntityIds() const
+{
+    return freeEntityIds.size() + (maxEntities - nextEntityIndex);
+}
+
+ECS::Entity ECS::Registry::takeEntityId()
+{
+    // reuse destroyed entities' slots before growing into new ones
+    if (!freeEntityIds.empty())
+    {
+        auto entity = freeEntityIds.back();
+        freeEntityIds.pop_back();
+
+        return entity;
+    }
+
+    return makeEntity(nextEntityIndex++, 0);
+}
+
+void ECS::Registry::addEntity(Entity entity)
+{
+    entities.push_back(entity);
+
+    auto index = entityIndex(entity);
+
+    if (index >= entityLocations.size())
+    {
+        entityLocations.resize(index + 1);
+    }
+
+    auto &location = entityLocations[index];
+    location.entity = entity;
+    location.index = entities.size() - 1;
+
+    setArchetype(entity, emptyArchetype);
+}
+
+void ECS::Registry::removeEntity(Entity entity)
+{
+    publishDestroyedSignals(*getLocation(entity).archetype, std::span<const Entity>(&entity, 1));
+
+    removeFromCachedViews(entity);
+
+    eraseEntity(entity);
+
+    // the next entity in the slot gets the next generation, so handles to this entity stay invalid
+    std::lock_guard<std::mutex> lock(freeEntityIdsMutex);
+    freeEntityIds.push_back(makeEntity(entityIndex(entity), entityGeneration(entity) + 1));
+}
+
+void ECS::Registry::eraseEntity(Entity entity)
+{
+    auto &location = getLocation(entity);
+
+    // swap remove entity from entities vector
+    auto last = entities.back();
+    entities[location.index] = last;
+    getLocation(last).index = location.index;
+    entities.pop_back();
+
+    // remove entity's components from the pools in its archetype
+    for (auto componentId : location.archetype->getSignature())
+    {
+        removeFromGroups(componentId, entity);
+        componentPools[componentId]->remove(entity);
+    }
+
+    setArchetype(entity, nullptr);
+
+    location.entity = NULL_ENTITY;
+}
+
+ECS::Archetype *ECS::Registry::getArchetype(const std::vector<ComponentId> &signature)
+{
+    auto it = archetypesBySignature.find(signature);
+    if (it != archetypesBySignature.end())
+    {
+        return it->second;
+    }
+
+    auto archetype = new Archetype(signature);
+
+    archetypes.push_back(archetype);
+    archetypesBySignature.emplace(signature, archetype);
+
+    return archetype;
+}
+
+void ECS::Registry::setArchetype(Entity entity, Archetype *archetype)
+{
+    auto &location = getLocation(entity);
+
+    if (location.archetype != nullptr)
+    {
+        // the entity swapped into the removed row needs its location updated
+        if (location.archetype->remove(location.row))
+        {
+            auto moved = location.archetype->getEntities()[location.row];
+            getLocation(moved).row = location.row;
+        }
+    }
+
+    location.archetype = archetype;
+
+    if (archetype != nullptr)
+    {
+        location.row = archetype->add(entity);
+    }
+}
+
+void ECS::Registry::moveArchetype(Entity entity, ComponentId componentId, bool added)
+{
+    auto current = getLocation(entity).archetype;
+    auto next = added ? current->getAddEdge(componentId) : current->getRemoveEdge(componentId);
+
+    if (next == nullptr)
+    {
+        auto signature = current->getSignature();
+
+        if (added)
+        {
+            signature.insert(std::upper_bound(signature.begin(), signature.end(), componentId), componentId);
+        }
+        else
+        {
+            signature.erase(std::lower_bound(signature.begin(), signature.end(), componentId));
+        }
+
+        next = getArchetype(signature);
+
+        if (added)
+        {
+            current->setAddEdge(componentId, next);
+            next->setRemoveEdge(componentId, current);
+        }
+        else
+        {
+            current->setRemoveEdge(componentId, next);
+            next->setAddEdge(componentId, current);
+        }
+    }
+
+    setArchetype(entity, next);
+}
+
+std::vector<ECS::Entity> ECS::Registry::collectArchetypeEntities(const ComponentMask &componentMask) const
+{
+    size_t count = 0;
+
+    for (auto archetype : archetypes)
+    {
+        if (archetype->size() > 0 && archetype->hasAll(componentMask))
+        {
+            count += archetype->size();
+        }
+    }
+
+    std::vector<Entity> entities;
+    entities.reserve(count);
+
+    for (auto archetype : archetypes)
+    {
+        if (archetype->size() > 0 && archetype->hasAll(componentMask))
+        {
+            auto &archetypeEntities = archetype->getEntities();
+            entities.insert(entities.end(), archetypeEntities.begin(), archetypeEntities.end());
+        }
+    }
+
+    return entities;
+}
+
+void ECS::Registry::clearEntities()
+{
+    entities.clear();
+
+    for (auto componentPool : componentPools)
+    {
+        delete componentPool;
+    }
+
+    // keep the slots, component IDs are dense so the same ones will be used again
+    std::fill(componentPools.begin(), componentPools.end(), nullptr);
+
+    for (auto archetype : archetypes)
+    {
+        archetype->clear();
+    }
+
+    entityLocations.clear();
+
+    for (auto group : groups)
+    {
+        group->size = 0;
+    }
+
+    // rebuild rather than delete the cached views, as persistent views point to them
+    for (auto &pair : cachedViews)
+    {
+        buildCachedView(*pair.second);
+    }
+}
+
+void ECS::Registry::writeSnapshotEntities(SnapshotWriter &writer, const SnapshotComponents &components) const
+{
+    writer.write<uint64_t>(entities.size());
+    writer.write(entities.data(), entities.size() * sizeof(Entity));
+
+    uint64_t archetypeCount = 0;
+    for (auto archetype : archetypes)
+    {
+        if (archetype->size() > 0)
+        {
+            archetypeCount++;
+        }
+    }
+
+    writer.write<uint64_t>(archetypeCount);
+
+    std::vector<uint64_t> signature;
+
+    for (auto archetype : archetypes)
+    {
+        if (archetype->size() == 0)
+        {
+            continue;
+        }
+
+        // archetypes which only differ by components that are not written are merged when read
+        signature.clear();
+
+        for (auto componentId : archetype->getSignature())
+        {
+            for (auto &[hash, id] : components)
+            {
+                if (id == componentId)
+                {
+                    signature.push_back(hash);
+                    break;
+                }
+            }
+        }
+
+        writer.write<uint64_t>(signature.size());
+        writer.write(signature.data(), signature.size() * sizeof(uint64_t));
+
+        auto &archetypeEntities = archetype->getEntities();
+
+        writer.write<uint64_t>(archetypeEntities.size());
+        writer.write(archetypeEntities.data(), archetypeEntities.size() * sizeof(Entity));
+    }
+}
+
+void ECS::Registry::readSnapshotEntities(SnapshotReader &reader, const SnapshotComponents &components)
+{
+    auto entityCount = reader.read<uint64_t>();
+    auto entityData = reader.readArray(entityCount, sizeof(Entity));
+
+    if (entityCount > maxEntities)
+    {
+        throw std::runtime_error("Registry (readSnapshotEntities): Snapshot has more entities than the registry can hold.");
+    }
+
+    entities.resize(entityCount);
+    std::memcpy(entities.data(), entityData, entityCount * sizeof(Entity));
+
+    size_t maxIndex = 0;
+
+    for (auto entity : entities)
+    {
+        if (entityIndex(entity) >= maxEntities)
+        {
+            throw std::runtime_error("Registry (readSnapshotEntities): Snapshot has an invalid entity '" + std::to_string(entity) + "'.");
+        }
+
+        maxIndex = std::max(maxIndex, entityIndex(entity));
+    }
+
+    entityLocations.resize(entityCount > 0 ? maxIndex + 1 : 0);
+
+    for (size_t i = 0; i < entities.size(); i++)
+    {
+        auto &location = getLocation(entities[i]);
+
+        if (location.entity != NULL_ENTITY)
+        {
+            throw std::runtime_error("Registry (readSnapshotEntities): Snapshot has a duplicate entity '" + std::to_string(entities[i]) + "'.");
+        }
+
+        location.entity = entities[i];
+        location.index = i;
+    }
+
+    auto archetypeCount = reader.read<uint64_t>();
+    size_t placed = 0;
+
+    for (uint64_t i = 0; i < archetypeCount; i++)
+    {
+        auto signatureSize = reader.read<uint64_t>();
+        auto signatureData = reader.readArray(signatureSize, sizeof(uint64_t));
+
+        std::vector<ComponentId> signature(signatureSize);
+
+        for (uint64_t j = 0; j < signatureSize; j++)
+        {
+            uint64_t hash;
+            std::memcpy(&hash, signatureData + j * sizeof(uint64_t), sizeof(uint64_t));
+
+            auto it = std::lower_bound(components.begin(), components.end(), hash, [](const auto &component, uint64_t hash)
+                                       { return component.first < hash; });
+
+            if (it == components.end() || it->first != hash)
+            {
+                throw std::runtime_error("Registry (readSnapshotEntities): Snapshot has component '" + std::to_string(hash) + "' which is not one of the given component types.");
+            }
+
+            signature[j] = it->second;
+        }
+
+        std::sort(signature.begin(), signature.end());
+
+        if (std::adjacent_find(signature.begin(), signature.end()) != signature.end())
+        {
+            throw std::runtime_error("Registry (readSnapshotEntities): Snapshot has an invalid archetype signature.");
+        }
+
+        auto archetype = getArchetype(signature);
+
+        auto archetypeEntityCount = reader.read<uint64_t>();
+        auto archetypeEntityData = reader.readArray(archetypeEntityCount, sizeof(Entity));
+
+        for (uint64_t j = 0; j < archetypeEntityCount; j++)
+        {
+            Entity entity;
+            std::memcpy(&entity, archetypeEntityData + j * sizeof(Entity), sizeof(Entity));
+
+            if (!has(entity) || getLocation(entity).archetype != nullptr)
+            {
+                throw std::runtime_error("Registry (readSnapshotEntities): Snapshot has an invalid or duplicate archetype entity '" + std::to_string(entity) + "'.");
+            }
+
+            auto &location = getLocation(entity);
+            location.archetype = archetype;
+            location.row = archetype->add(entity);
+        }
+
+        placed += archetypeEntityCount;
+    }
+
+    // every entity is in exactly one archetype
+    if (placed != entities.size())
+    {
+        throw std::runtime_error("Registry (readSnapshotEntities): Snapshot has entities which are not in an archetype.");
+    }
+}
+
+void ECS::Registry::finishSnapshot()
+{
+    for (auto archetype : archetypes)
+    {
+        if (archetype->size() == 0)
+        {
+            continue;
+        }
+
+        for (auto componentId : archetype->getSignature())
+        {
+            if (!hasComponentPool(componentId))
+            {
+                throw std::runtime_error("Registry (finishSnapshot): Snapshot has an archetype with component '" + std::to_string(componentId) + "' but no pool for it.");
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(freeEntityIdsMutex);
+
+        std::vector<Entity> free;
+
+        // slots which are still free keep their generation, so handles from before the snapshot stay invalid
+        for (auto entity : freeEntityIds)
+        {
+            auto index = entityIndex(entity);
+
+            if (index >= entityLocations.size() || entityLocations[index].entity == NULL_ENTITY)
+            {
+                free.push_back(entity);
+            }
+        }
+
+        // slots below the snapshot's highest entity which had never been handed out
+        for (size_t index = nextEntityIndex; index < entityLocations.size(); index++)
+        {
+            if (entityLocations[index].entity == NULL_ENTITY)
+            {
+                free.push_back(makeEntity(index, 0));
+            }
+        }
+
+        nextEntityIndex = std::max(nextEntityIndex, entityLocations.size());
+
+        freeEntityIds.swap(free);
+    }
+
+    for (auto &pair : cachedViews)
+    {
+        buildCachedView(*pair.second);
+    }
+
+    for (auto group : groups)
+    {
+        buildGroup(*group);
+    }
+}
+
+void ECS::Registry::createGroup(const std::vector<ComponentId> &componentIds)
+{
+    auto group = new Group{componentIds, ComponentMask(componentIds), 0};
+
+    groups.push_back(group);
+
+    for (auto componentId : componentIds)
+    {
+        if (componentId >= groupsByComponent.size())
+        {
+            groupsByComponent.resize(componentId + 1, nullptr);
+        }
+
+        groupsByComponent[componentId] = group;
+    }
+
+    buildGroup(*group);
+}
+
+ECS::Registry::Group *ECS::Registry::findGroup(const std::vector<ComponentId> &componentIds) const
+{
+    if (componentIds.empty())
+    {
+        return nullptr;
+    }
+
+    auto group = getOwningGroup(componentIds[0]);
+    if (group == nullptr || group->componentIds != componentIds)
+    {
+        return nullptr;
+    }
+
+    return group;
+}
+
+const ECS::Registry::Group &ECS::Registry::getGroup(const std::vector<ComponentId> &componentIds) const
+{
+    auto group = findGroup(componentIds);
+    if (group == nullptr)
+    {
+        throw std::runtime_error("Registry (getGroup): Group does not exist.");
+    }
+
+    return *group;
+}
+
+void ECS::Registry::buildGroup(Group &group)
+{
+    group.size = 0;
+
+    // pools are created when a component is first added, so after destroyAll an owned pool may not exist yet
+    for (auto componentId : group.componentIds)
+    {
+        if (!hasComponentPool(componentId))
+        {
+            return;
+        }
+    }
+
+    for (auto entity : collectArchetypeEntities(group.mask))
+    {
+        addToGroup(group, entity);
+    }
+}
+
+void ECS::Registry::addToGroup(Group &group, Entity entity)
+{
+    for (auto componentId : group.componentIds)
+    {
+        auto componentPool = componentPools[componentId];
+        componentPool->swap(componentPool->getIndex(entity), group.size);
+    }
+
+    group.size++;
+}
+
+void ECS::Registry::removeFromGroup(Group &group, Entity entity)
+{
+    group.size--;
+
+    for (auto componentId : group.componentIds)
+    {
+        auto componentPool = componentPools[componentId];
+        componentPool->swap(componentPool->getIndex(entity), group.size);
+    }
+}
+
+void ECS::Registry::addToGroups(ComponentId componentId, Entity entity)
+{
+    auto owningGroup = getOwningGroup(componentId);
+    if (owningGroup == nullptr)
+    {
+        return;
+    }
+
+    auto &group = *owningGroup;
+
+    // the entity only joins the group once it has every owned component
+    if (getLocation(entity).archetype->hasAll(group.mask))
+    {
+        addToGroup(group, entity);
+    }
+}
+
+void ECS::Registry::removeFromGroups(ComponentId componentId, Entity entity)
+{
+    auto owningGroup = getOwningGroup(componentId);
+    if (owningGroup == nullptr)
+    {
+        return;
+    }
+
+    auto &group = *owningGroup;
+
+    // the entity is in the group if its component is in the packed front of the pool
+    auto index = componentPools[componentId]->getIndex(entity);
+
+    if (index != PagedIndexArray::NULL_INDEX && index < group.size)
+    {
+        removeFromGroup(group, entity);
+    }
+}
+
+void ECS::Registry::arrangeComponentPool(ComponentId componentId, const Entity *ids, size_t count)
+{
+    auto componentPool = componentPools[componentId];
+
+    for (size_t i = 0; i < count; i++)
+    {
+        componentPool->swap(i, componentPool->getIndex(ids[i]));
+    }
+}
+
+void ECS::Registry::updateCachedViews(ComponentId componentId, ECS::Entity e)
+{
+    auto archetype = getLocation(e).archetype;
+
+    for (auto &[components, view] : cachedViews)
+    {
+        if (view->mask.test(componentId) && archetype->hasAll(view->mask))
+        {
+            addToCachedView(*view, e);
+        }
+    }
+}
+
+void ECS::Registry::removeFromCachedViews(ComponentId componentId, Entity e)
+{
+    for (auto &[components, view] : cachedViews)
+    {
+        if (view->mask.test(componentId))
+        {
+            removeFromCachedView(*view, e);
+        }
+    }
+}
+
+void ECS::Registry::removeFromCachedViews(Entity e)
+{
+    auto archetype = getLocation(e).archetype;
+
+    // the entity can only be in the views whose components it has
+    for (auto &[components, view] : cachedViews)
+    {
+        if (archetype->hasAll(view->mask))
+        {
+            removeFromCachedView(*view, e);
+        }
+    }
+}
+
+std::vector<ECS::ComponentId> ECS::Registry::createViewKey(std::vector<ComponentId> componentIds)
+{
+    std::sort(componentIds.begin(), componentIds.end());
+    componentIds.erase(std::unique(componentIds.begin(), componentIds.end()), componentIds.end());
+
+    return componentIds;
+}
+
+ECS::CachedView &ECS::Registry::getCachedView(const std::vector<ComponentId> &key) const
+{
+    // views can be requested by systems running in parallel
+    std::lock_guard<std::mutex> lock(cachedViewsMutex);
+
+    auto it = cachedViews.find(key);
+    if (it != cachedViews.end())
+    {
+        return *it->second;
+    }
+
+    auto view = new CachedView();
+    view->componentIds = key;
+    view->mask = ComponentMask(key);
+    buildCachedView(*view);
+
+    cachedViews.emplace(key, view);
+
+    return *view;
+}
+
+const ECS::CachedView *ECS::Registry::findCachedView(const std::vector<ComponentId> &key) const
+{
+    std::lock_guard<std::mutex> lock(cachedViewsMutex);
+
+    auto it = cachedViews.find(key);
+
+    return it != cachedViews.end() ? it->second : nullptr;
+}
+
+void ECS::Registry::buildCachedView(CachedView &view) const
+{
+    view.timestamp = Core::timeSinceEpochMicrosec();
+    view.entities = collectArchetypeEntities(view.mask);
+
+    view.indices.clear();
+    view.addedIndices.clear();
+    view.addedSinceTimestamp.clear();
+    view.removedSinceTimestamp.clear();
+
+    for (size_t i = 0; i < view.entities.size(); i++)
+    {
+        view.indices.set(entityIndex(view.entities[i]), static_cast<uint32_t>(i));
+    }
+}
+
+void ECS::Registry::addToCachedView(CachedView &view, Entity e)
+{
+    view.indices.set(entityIndex(e), static_cast<uint32_t>(view.entities.size()));
+    view.entities.push_back(e);
+
+    view.addedIndices.set(entityIndex(e), static_cast<uint32_t>(view.addedSinceTimestamp.size()));
+    view.addedSinceTimestamp.push_back(e);
+
+    checkCachedViewThreshold(view);
+}
+
+void ECS::Registry::removeFromCachedView(CachedView &view, Entity e)
+{
+    auto index = view.indices.get(entityIndex(e));
+    if (index == PagedIndexArray::NULL_INDEX)
+    {
+        return;
+    }
+
+    // swap remove from entities
+    auto last = view.entities.back();
+    view.entities[index] = last;
+    view.indices.set(entityIndex(last), index);
+    view.entities.pop_back();
+    view.indices.reset(entityIndex(e));
+
+    // if the entity was added since the timestamp, it was either not in the view when it was cached,
+    // or its earlier removal is already recorded, so forgetting the addition is enough
+    auto addedIndex = view.addedIndices.get(entityIndex(e));
+    if (addedIndex != PagedIndexArray::NULL_INDEX)
+    {
+        auto lastAdded = view.addedSinceTimestamp.back();
+        view.addedSinceTimestamp[addedIndex] = lastAdded;
+        view.addedIndices.set(entityIndex(lastAdded), addedIndex);
+        view.addedSinceTimestamp.pop_back();
+        view.addedIndices.reset(entityIndex(e));
+
+        return;
+    }
+
+    view.removedSinceTimestamp.push_back(e);
+
+    checkCachedViewThreshold(view);
+}
+
+void ECS::Registry::checkCachedViewThreshold(CachedView &view)
+{
+    if (view.addedSinceTimestamp.size() + view.removedSinceTimestamp.size() <= cacheUpdateInvalidationThreshold)
+    {
+        return;
+    }
+
+    for (auto e : view.addedSinceTimestamp)
+    {
+        view.addedIndices.reset(entityIndex(e));
+    }
+
+    view.addedSinceTimestamp.clear();
+    view.removedSinceTimestamp.clear();
+    view.timestamp = Core::timeSinceEpochMicrosec();
+}
+
+void ECS::Registry::checkStructuralChange(const char *method) const
+{
+    if (structuralChangeLocks > 0)
+    {
+        throw std::runtime_error(std::string("Registry (") + method + "): cannot create or destroy entities or add or remove components during parallelEach or a component signal.");
+    }
+}
+
+void ECS::Registry::publishConstructedSignals(const Archetype &archetype, std::span<const Entity> entities) const
+{
+    for (auto componentId : archetype.getSignature())
+    {
+        componentSignalPublishers[componentId].constructed(*this, entities);
+    }
+}
+
+void ECS::Registry::publishDestroyedSignals(const Archetype &archetype, std::span<const Entity> entities) const
+{
+    for (auto componentId : archetype.getSignature())
+    {
+        componentSignalPublishers[componentId].destroyed(*this, entities);
+    }
 }
\ No newline at end of file
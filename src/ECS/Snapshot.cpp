@@ -0,0 +1,80 @@
+#include "../../include/ECS/Snapshot.h"
+#include "../../include/ECS/Entity.h"
+
+#include <stdexcept>
+#include <string>
+
+ECS::SnapshotWriter::SnapshotWriter(std::ostream &stream) : stream(stream)
+{
+}
+
+void ECS::SnapshotWriter::writeHeader()
+{
+    write<uint32_t>(ECS_SNAPSHOT_MAGIC);
+    write<uint32_t>(ECS_SNAPSHOT_VERSION);
+    write<uint32_t>(sizeof(Entity));
+}
+
+void ECS::SnapshotWriter::write(const void *data, size_t size)
+{
+    stream.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(size));
+
+    if (!stream)
+    {
+        throw std::runtime_error("SnapshotWriter (write): Failed to write to stream.");
+    }
+}
+
+ECS::SnapshotReader::SnapshotReader(const std::byte *data, size_t size) : data(data), size(size)
+{
+}
+
+void ECS::SnapshotReader::readHeader()
+{
+    if (read<uint32_t>() != ECS_SNAPSHOT_MAGIC)
+    {
+        throw std::runtime_error("SnapshotReader (readHeader): Data is not a snapshot.");
+    }
+
+    auto version = read<uint32_t>();
+    if (version != ECS_SNAPSHOT_VERSION)
+    {
+        throw std::runtime_error("SnapshotReader (readHeader): Snapshot version " + std::to_string(version) + " is not supported, expected version " + std::to_string(ECS_SNAPSHOT_VERSION) + ".");
+    }
+
+    // entities are written in their native size
+    auto entitySize = read<uint32_t>();
+    if (entitySize != sizeof(Entity))
+    {
+        throw std::runtime_error("SnapshotReader (readHeader): Snapshot has " + std::to_string(entitySize * 8) + " bit entities, expected " + std::to_string(sizeof(Entity) * 8) + " bit entities.");
+    }
+}
+
+const std::byte *ECS::SnapshotReader::read(size_t size)
+{
+    if (size > getRemaining())
+    {
+        throw std::runtime_error("SnapshotReader (read): Unexpected end of snapshot.");
+    }
+
+    auto bytes = data + offset;
+    offset += size;
+
+    return bytes;
+}
+
+const std::byte *ECS::SnapshotReader::readArray(uint64_t count, size_t elementSize)
+{
+    // checked by division so a corrupt count cannot overflow the size
+    if (elementSize != 0 && count > getRemaining() / elementSize)
+    {
+        throw std::runtime_error("SnapshotReader (readArray): Unexpected end of snapshot.");
+    }
+
+    return read(static_cast<size_t>(count) * elementSize);
+}
+
+size_t ECS::SnapshotReader::getRemaining() const
+{
+    return size - offset;
+}
\ No newline at end of file
@@ -37,7 +37,10 @@ remi::Engine::Engine(EngineConfig config)
     std::cout << "Default render pipeline:" << std::endl;
     std::cout << pipeline->toString() << std::endl;
 
+    jobSystem = new Core::JobSystem(config.workerThreads, config.pinWorkerThreads);
+
     world = new World::World(config.maxEntities);
+    world->setJobSystem(jobSystem);
 
     spaceTransformer = new Core::SpaceTransformer(renderer, world, config.pixelsPerMeter);
 
@@ -77,6 +80,7 @@ remi::Engine::~Engine()
     delete renderManager;
     delete spaceTransformer;
     delete world;
+    delete jobSystem;
     delete pipeline;
     delete renderer;
     delete window;
@@ -105,6 +109,9 @@ void remi::Engine::run()
     // poll for events before first update
     window->pollEvents();
 
+    // apply commands recorded during setup
+    world->getCommandBuffer().apply();
+
     // pre update scene graph
     auto &sceneGraph = world->getSceneGraph();
     sceneGraph.updateModelMatrices();
@@ -112,7 +119,7 @@ void remi::Engine::run()
     // pre update physics world
     // this will make sure that the physics world is in sync with the world before the first update
     auto timestep = Core::Timestep(0);
-    physicsWorld->fixedUpdate(createSystemUpdateData(timestep));
+    world->fixedUpdateUnscheduled(physicsWorld, createSystemUpdateData(timestep));
 
 #ifdef __EMSCRIPTEN__
     std::function<void()> mainLoopWrapper = std::bind(&Engine::mainLoop, this, args);
@@ -160,6 +167,11 @@ Physics::PhysicsWorld *const remi::Engine::getPhysicsWorld()
     return physicsWorld;
 }
 
+Core::JobSystem *const remi::Engine::getJobSystem()
+{
+    return jobSystem;
+}
+
 World::World *const remi::Engine::getWorld()
 {
     return world;
@@ -204,7 +216,8 @@ ECS::System::SystemUpdateData remi::Engine::createSystemUpdateData(const Core::T
                                          *mouse,
                                          *keyboard,
                                          *soundEffectManager,
-                                         *musicManager};
+                                         *musicManager,
+                                         *jobSystem};
 }
 
 void remi::Engine::mainLoop(MainLoopArgs *args)
@@ -225,7 +238,15 @@ void remi::Engine::mainLoop(MainLoopArgs *args)
         auto data = createSystemUpdateData(fixedTimestep);
 
         world->fixedUpdate(data);
-        physicsWorld->fixedUpdate(data);
+
+        // sync point, so bodies are created for entities created by fixed updates
+        world->getCommandBuffer().apply();
+
+        // run by the world so its time and touched bodies are included in the system stats
+        world->fixedUpdateUnscheduled(physicsWorld, data);
+
+        // sync point, for commands recorded by contact callbacks during the physics step
+        world->getCommandBuffer().apply();
 
         timeSinceLastFixedUpdate = 0;
 
@@ -260,6 +281,9 @@ void remi::Engine::mainLoop(MainLoopArgs *args)
 
         world->update(data);
 
+        // sync point, so the frame renders the changes recorded by updates
+        world->getCommandBuffer().apply();
+
         // no need to render if window is minimized
         if (!isMinimized)
         {
@@ -40,7 +40,7 @@ bool Input::KeyModifier::numLock()
 Input::Keyboard::Keyboard(Core::Window &window)
     : window(window)
 {
-    window.attachObserver(Core::WindowPollEventName, this);
+    pollListenerId = window.getEventBus().subscribe<Core::WindowPollEvent, &Keyboard::onPoll>(this);
 
     // set initial values
     for (int i = 0; i < Key::__LAST_KEY__; i++)
@@ -52,7 +52,7 @@ Input::Keyboard::Keyboard(Core::Window &window)
 
 Input::Keyboard::~Keyboard()
 {
-    window.detachObserver(Core::WindowPollEventName, this);
+    window.getEventBus().unsubscribe<Core::WindowPollEvent>(pollListenerId);
 }
 
 bool Input::Keyboard::isPressed(Key key) const
@@ -65,9 +65,9 @@ Input::KeyModifier Input::Keyboard::getModifiers(Key key) const
     return KeyModifier(mods[key]);
 }
 
-void Input::Keyboard::updateObserver(std::string event, const std::vector<SDL_Event> &data)
+void Input::Keyboard::onPoll(const Core::WindowPollEvent &pollEvent)
 {
-    for (auto &event : data)
+    for (auto &event : pollEvent.events)
     {
         switch (event.type)
         {
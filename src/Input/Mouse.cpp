@@ -5,7 +5,7 @@
 Input::Mouse::Mouse(Core::Window &window)
     : window(window)
 {
-    window.attachObserver(Core::WindowPollEventName, this);
+    pollListenerId = window.getEventBus().subscribe<Core::WindowPollEvent, &Mouse::onPoll>(this);
 
     // set initial values
     for (int i = 0; i < MouseButton::__LAST_MOUSE_BUTTON__; i++)
@@ -18,7 +18,7 @@ Input::Mouse::Mouse(Core::Window &window)
 
 Input::Mouse::~Mouse()
 {
-    window.detachObserver(Core::WindowPollEventName, this);
+    window.getEventBus().unsubscribe<Core::WindowPollEvent>(pollListenerId);
 }
 
 glm::vec2 Input::Mouse::getPosition(bool flipY) const
@@ -80,9 +80,9 @@ Input::MouseMode Input::Mouse::getMode() const
     return MouseMode::HIDDEN;
 }
 
-void Input::Mouse::updateObserver(std::string event, const std::vector<SDL_Event> &data)
+void Input::Mouse::onPoll(const Core::WindowPollEvent &pollEvent)
 {
-    for (auto &event : data)
+    for (auto &event : pollEvent.events)
     {
         switch (event.type)
         {
@@ -26,14 +26,9 @@ Physics::Collider2D::Collider2D(const Collider2D &other)
     // fixtures = other.fixtures;
 }
 
-Physics::Collider2D::Collider2D(const Collider2D &&other)
+Physics::Collider2D::Collider2D(Collider2D &&other) noexcept
 {
-    if (other.shape == nullptr)
-    {
-        throw std::invalid_argument("Collider 2D (move constructor): other collider shape is null.");
-    }
-
-    shape = other.shape->clone();
+    shape = other.shape;
     density = other.density;
     friction = other.friction;
     restitution = other.restitution;
@@ -41,7 +36,8 @@ Physics::Collider2D::Collider2D(const Collider2D &&other)
     isSensor = other.isSensor;
     fixtures = nullptr;
     filter = other.filter;
-    // fixtures = other.fixtures;
+
+    other.shape = nullptr;
 }
 
 Physics::Collider2D &Physics::Collider2D::operator=(const Physics::Collider2D &other)
@@ -69,11 +65,11 @@ Physics::Collider2D &Physics::Collider2D::operator=(const Physics::Collider2D &o
     return *this;
 }
 
-Physics::Collider2D &Physics::Collider2D::operator=(const Physics::Collider2D &&other)
+Physics::Collider2D &Physics::Collider2D::operator=(Physics::Collider2D &&other) noexcept
 {
-    if (other.shape == nullptr)
+    if (this == &other)
     {
-        throw std::invalid_argument("Collider 2D (move assignment): other collider shape is null.");
+        return *this;
     }
 
     if (this->shape != nullptr)
@@ -81,7 +77,7 @@ Physics::Collider2D &Physics::Collider2D::operator=(const Physics::Collider2D &&
         delete this->shape;
     }
 
-    shape = other.shape->clone();
+    shape = other.shape;
     density = other.density;
     friction = other.friction;
     restitution = other.restitution;
@@ -89,7 +85,8 @@ Physics::Collider2D &Physics::Collider2D::operator=(const Physics::Collider2D &&
     isSensor = other.isSensor;
     fixtures = nullptr;
     filter = other.filter;
-    // fixtures = other.fixtures;
+
+    other.shape = nullptr;
 
     return *this;
 }
@@ -278,6 +275,11 @@ std::vector<b2Fixture *> *Physics::Collider2D::getFixtures()
     return fixtures;
 }
 
+const std::vector<b2Fixture *> *Physics::Collider2D::getFixtures() const
+{
+    return fixtures;
+}
+
 void Physics::Collider2D::setFixtures(std::vector<b2Fixture *> *fixtures)
 {
     this->fixtures = fixtures;
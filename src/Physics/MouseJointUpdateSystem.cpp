@@ -1,4 +1,7 @@
 #include "../../include/Physics/MouseJointUpdateSystem.h"
+#include "../../include/Rendering/Camera/ActiveCamera.h"
+#include "../../include/Rendering/Camera/Camera.h"
+#include "../../include/Core/Transform.h"
 
 Physics::MouseJointUpdateSystem::MouseJointUpdateSystem(Input::Mouse *mouse, Core::SpaceTransformer *spaceTransformer)
     : mouse(mouse), spaceTransformer(spaceTransformer)
@@ -12,6 +15,13 @@ Physics::MouseJointUpdateSystem::MouseJointUpdateSystem(Input::Mouse *mouse, Cor
     {
         throw std::invalid_argument("MouseJointUpdateSystem (constructor): Space transformer cannot be null.");
     }
+
+    declareWrite<MouseJoint>();
+
+    // the space transformer reads the active camera
+    declareRead<Core::Transform>();
+    declareRead<Rendering::Camera>();
+    declareRead<Rendering::ActiveCamera>();
 }
 
 void Physics::MouseJointUpdateSystem::update(const ECS::System::SystemUpdateData &data)
@@ -22,15 +32,17 @@ void Physics::MouseJointUpdateSystem::update(const ECS::System::SystemUpdateData
     auto mouseWorld = this->spaceTransformer->transform(mouse, Core::SpaceTransformer::Space::SCREEN, Core::SpaceTransformer::Space::WORLD);
 
     auto &registry = world.getRegistry();
-    auto entities = registry.view<MouseJoint>();
 
-    for (auto entity : entities)
-    {
-        auto &joint = registry.get<MouseJoint>(entity);
+    size_t touched = 0;
 
-        if (joint.getAutoUpdate())
-        {
-            joint.setTarget(mouseWorld);
-        }
-    }
+    registry.each<MouseJoint>([&mouseWorld, &touched](ECS::Entity, MouseJoint &joint)
+                              {
+                                  touched++;
+
+                                  if (joint.getAutoUpdate())
+                                  {
+                                      joint.setTarget(mouseWorld);
+                                  } });
+
+    addTouchedEntities(touched);
 }
\ No newline at end of file
@@ -21,6 +21,7 @@
 #include <box2d/b2_circle_shape.h>
 #include <box2d/b2_fixture.h>
 #include <box2d/b2_contact.h>
+#include <algorithm>
 #include <cstdint>
 #include <unordered_set>
 #include <string>
@@ -36,11 +37,48 @@ Physics::PhysicsWorld::PhysicsWorld(PhysicsWorldConfig config, const World::Worl
     mouseJointStaticBodyDef.type = b2_staticBody;
 
     mouseJointStaticBody = world.CreateBody(&mouseJointStaticBodyDef);
+
+    // keep track of the entities which may need a body created or destroyed instead of diffing all bodies every step
+    signalRegistry = &entityWorld->getRegistry();
+    auto &signals = signalRegistry->getSignals();
+
+    auto addPending = [this](ECS::Entity entity)
+    {
+        pendingBodyEntities.push_back(entity);
+    };
+
+    transformConstructedListenerId = signals.subscribe<ECS::ComponentConstructed<Core::Transform>>([addPending](const ECS::ComponentConstructed<Core::Transform> &signal)
+                                                                                                    { addPending(signal.entity); });
+    transformDestroyedListenerId = signals.subscribe<ECS::ComponentDestroyed<Core::Transform>>([addPending](const ECS::ComponentDestroyed<Core::Transform> &signal)
+                                                                                                { addPending(signal.entity); });
+    rigidBodyConstructedListenerId = signals.subscribe<ECS::ComponentConstructed<RigidBody2D>>([addPending](const ECS::ComponentConstructed<RigidBody2D> &signal)
+                                                                                                { addPending(signal.entity); });
+    rigidBodyDestroyedListenerId = signals.subscribe<ECS::ComponentDestroyed<RigidBody2D>>([addPending](const ECS::ComponentDestroyed<RigidBody2D> &signal)
+                                                                                            { addPending(signal.entity); });
+
+    // the registry may be destroyed first, in which case there is nothing to unsubscribe from
+    registryDestroyedListenerId = signals.subscribe<ECS::RegistryDestroyed>([this](const ECS::RegistryDestroyed &)
+                                                                            { signalRegistry = nullptr; });
+
+    // entities which already have a body's components were created before the listeners
+    signalRegistry->each<Core::Transform, RigidBody2D>([this](ECS::Entity entity, const Core::Transform &, const RigidBody2D &)
+                                                       { pendingBodyEntities.push_back(entity); });
 }
 
 Physics::PhysicsWorld::~PhysicsWorld()
 {
-    // TODO: implement
+    if (signalRegistry == nullptr)
+    {
+        return;
+    }
+
+    auto &signals = signalRegistry->getSignals();
+
+    signals.unsubscribe<ECS::ComponentConstructed<Core::Transform>>(transformConstructedListenerId);
+    signals.unsubscribe<ECS::ComponentDestroyed<Core::Transform>>(transformDestroyedListenerId);
+    signals.unsubscribe<ECS::ComponentConstructed<RigidBody2D>>(rigidBodyConstructedListenerId);
+    signals.unsubscribe<ECS::ComponentDestroyed<RigidBody2D>>(rigidBodyDestroyedListenerId);
+    signals.unsubscribe<ECS::RegistryDestroyed>(registryDestroyedListenerId);
 }
 
 void Physics::PhysicsWorld::fixedUpdate(const ECS::System::SystemUpdateData &data)
@@ -57,11 +95,19 @@ void Physics::PhysicsWorld::fixedUpdate(const ECS::System::SystemUpdateData &dat
     // create, destroy and update joints with ECS values
     updateJoints(world, timestep);
 
+    // taken before stepping, so transforms written during the step, e.g. by contact callbacks, can be told apart from physics' own writes
+    auto stepTick = world.getRegistry().advanceChangeTick();
+
     // step box2d world
     this->world.Step(timestep.getSeconds(), config.velocityIterations, config.positionIterations);
 
     // update ECS values with box2d values
-    updateECSWithBox2DValues(world);
+    updateECSWithBox2DValues(world, stepTick);
+
+    addTouchedEntities(bodies.size());
+
+    // taken after writing box2d values to the ECS, so only changes made outside of physics are injected into box2d next update
+    lastChangeTick = world.getRegistry().advanceChangeTick();
 
     // auto body = this->world.GetBodyList();
     // while (body != nullptr)
@@ -253,27 +299,31 @@ void Physics::PhysicsWorld::updateBodies(World::World &world)
 {
     auto &registry = world.getRegistry();
 
-    auto &entities = registry.view<Core::Transform, Physics::RigidBody2D>();
-    std::unordered_set<ECS::Entity> entitySet(entities.begin(), entities.end());
-
+    std::unordered_set<ECS::Entity> entitySet;
     std::vector<b2Body *> bodiesToDestroy;
 
-    // check if any bodies need to be removed or added
-    for (auto &[entity, body] : bodies)
+    // an entity is pending once per component added or removed, so check each one once
+    std::sort(pendingBodyEntities.begin(), pendingBodyEntities.end());
+    pendingBodyEntities.erase(std::unique(pendingBodyEntities.begin(), pendingBodyEntities.end()), pendingBodyEntities.end());
+
+    // only entities whose transform or rigid body was added or removed since the last step can need their bodies created or destroyed
+    for (auto &entity : pendingBodyEntities)
     {
-        // entity is not in the registry or no longer a valid body
-        if (!entitySet.contains(entity))
+        bool isBody = registry.has<Core::Transform>(entity) && registry.has<Physics::RigidBody2D>(entity);
+        bool hasBody = bodies.contains(entity);
+
+        if (hasBody && !isBody)
         {
-            bodiesToDestroy.push_back(body);
+            bodiesToDestroy.push_back(bodies[entity]);
         }
-        // remove the entity from the set if it is still a valid body
-        // it does not need to be created
-        else
+        else if (!hasBody && isBody)
         {
-            entitySet.erase(entity);
+            entitySet.insert(entity);
         }
     }
 
+    pendingBodyEntities.clear();
+
     // destroy bodies
     for (auto &body : bodiesToDestroy)
     {
@@ -288,7 +338,7 @@ void Physics::PhysicsWorld::updateBodies(World::World &world)
     updateBodiesWithECSValues(world, entitySet);
 }
 
-void Physics::PhysicsWorld::createBodies(const World::World &world, const std::unordered_set<ECS::Entity> &entitySet)
+void Physics::PhysicsWorld::createBodies(World::World &world, const std::unordered_set<ECS::Entity> &entitySet)
 {
     auto &registry = world.getRegistry();
     auto &sceneGraph = world.getSceneGraph();
@@ -380,9 +430,9 @@ void Physics::PhysicsWorld::destroyBody(World::World &world, b2Body *body)
     this->world.DestroyBody(body);
 }
 
-void Physics::PhysicsWorld::updateBodiesWithECSValues(const World::World &world, const std::unordered_set<ECS::Entity> &createdEntities)
+void Physics::PhysicsWorld::updateBodiesWithECSValues(World::World &world, const std::unordered_set<ECS::Entity> &createdEntities)
 {
-    auto &registry = world.getRegistry();
+    const auto &registry = world.getRegistry();
     auto &sceneGraph = world.getSceneGraph();
 
     for (auto &[e, box2dBody] : bodies)
@@ -393,17 +443,19 @@ void Physics::PhysicsWorld::updateBodiesWithECSValues(const World::World &world,
             continue;
         }
 
-        auto transform = Core::Transform(sceneGraph.getModelMatrix(e));
-        auto &body = registry.get<Physics::RigidBody2D>(e);
+        // update transform, only if it has changed outside of physics since the last update
+        if (sceneGraph.hasWorldTransformChanged(e, lastChangeTick))
+        {
+            auto transform = Core::Transform(sceneGraph.getModelMatrix(e));
 
-        // update transform
-        auto &box2dPos = box2dBody->GetPosition();
-        auto &translation = transform.getTranslation();
-        auto rotation = transform.getRotation();
+            auto &box2dPos = box2dBody->GetPosition();
+            auto &translation = transform.getTranslation();
+            auto rotation = transform.getRotation();
 
-        if (box2dPos.x != translation.x || box2dPos.y != translation.y || box2dBody->GetAngle() != rotation)
-        {
-            box2dBody->SetTransform(b2Vec2(translation.x, translation.y), rotation);
+            if (box2dPos.x != translation.x || box2dPos.y != translation.y || box2dBody->GetAngle() != rotation)
+            {
+                box2dBody->SetTransform(b2Vec2(translation.x, translation.y), rotation);
+            }
         }
 
         // update collider
@@ -439,7 +491,7 @@ void Physics::PhysicsWorld::updateBodiesWithECSValues(const World::World &world,
     }
 }
 
-void Physics::PhysicsWorld::createBox2DCollider(const World::World &world, ECS::Entity e)
+void Physics::PhysicsWorld::createBox2DCollider(World::World &world, ECS::Entity e)
 {
     if (!bodies.contains(e))
     {
@@ -518,11 +570,22 @@ void Physics::PhysicsWorld::destroyBox2DCollider(ECS::Entity e)
     colliders.erase(e);
 }
 
-void Physics::PhysicsWorld::updateECSWithBox2DValues(const World::World &world)
+void Physics::PhysicsWorld::updateECSWithBox2DValues(World::World &world, uint64_t stepTick)
 {
     auto &registry = world.getRegistry();
     auto &sceneGraph = world.getSceneGraph();
 
+    // found before writing any transforms, as physics' writes to a parent would mark its children as changed
+    std::unordered_set<ECS::Entity> changedDuringStep;
+
+    for (auto &[e, box2dBody] : bodies)
+    {
+        if (registry.has<Core::Transform>(e) && sceneGraph.hasWorldTransformChanged(e, stepTick))
+        {
+            changedDuringStep.insert(e);
+        }
+    }
+
     for (auto &[e, box2dBody] : bodies)
     {
         // user code could have removed the transform or rigid body
@@ -532,7 +595,6 @@ void Physics::PhysicsWorld::updateECSWithBox2DValues(const World::World &world)
             continue;
         }
 
-        auto &localTransform = registry.get<Core::Transform>(e);
         auto worldTransform = Core::Transform(sceneGraph.getModelMatrix(e));
 
         auto &body = registry.get<Physics::RigidBody2D>(e);
@@ -544,8 +606,17 @@ void Physics::PhysicsWorld::updateECSWithBox2DValues(const World::World &world)
         auto &translation = worldTransform.getTranslation();
         auto rotation = worldTransform.getRotation();
 
-        if (box2dPos.x != translation.x || box2dPos.y != translation.y || box2dRotation != rotation)
+        // the transform was written during the step, after lastChangeTick is taken it would no longer be seen as changed
+        // so inject it into box2d now instead of overwriting it
+        if (changedDuringStep.contains(e))
         {
+            box2dBody->SetTransform(b2Vec2(translation.x, translation.y), rotation);
+        }
+        // only take the transform for modification when it moved, so bodies at rest are not recorded as changed
+        else if (box2dPos.x != translation.x || box2dPos.y != translation.y || box2dRotation != rotation)
+        {
+            auto &localTransform = registry.get<Core::Transform>(e);
+
             auto localTranslation = spaceTransformer->transform(glm::vec2(box2dPos.x, box2dPos.y), e, Core::SpaceTransformer::Space::WORLD, Core::SpaceTransformer::Space::LOCAL);
             localTransform.setTranslation(localTranslation);
 
@@ -1,21 +1,21 @@
 #include "../../../include/Rendering/Material/MaterialHelpers.h"
 
-Rendering::Material *Rendering::getMaterial(const ECS::Registry &registry, ECS::Entity entity)
+const Rendering::Material *Rendering::getMaterial(const ECS::Registry &registry, ECS::Entity entity)
 {
-    if (registry.has<ShaderMaterial>(entity))
+    if (auto shaderMaterial = registry.tryGet<ShaderMaterial>(entity))
     {
-        return &registry.get<ShaderMaterial>(entity);
+        return shaderMaterial;
     }
-    else if (registry.has<AnimatedMaterial>(entity))
+    else if (auto animatedMaterial = registry.tryGet<AnimatedMaterial>(entity))
     {
-        return &registry.get<AnimatedMaterial>(entity);
+        return animatedMaterial;
     }
-    else if (!registry.has<Material>(entity))
+    else if (auto material = registry.tryGet<Material>(entity))
     {
-        throw std::invalid_argument("Entity " + std::to_string(entity) + " does not have a material, shader material or animated material.");
+        return material;
     }
     else
     {
-        return &registry.get<Material>(entity);
+        throw std::invalid_argument("Entity " + std::to_string(entity) + " does not have a material, shader material or animated material.");
     }
 }
\ No newline at end of file
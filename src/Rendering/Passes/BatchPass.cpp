@@ -5,7 +5,8 @@
 #include "../../../include/Rendering/Passes/CullingPass.h"
 #include "../../../include/Rendering/Renderer.h"
 
-#include <map>
+#include <algorithm>
+#include <utility>
 
 Rendering::RenderPassInput *Rendering::BatchPass::execute(RenderPassInput *input)
 {
@@ -16,7 +17,7 @@ Rendering::RenderPassInput *Rendering::BatchPass::execute(RenderPassInput *input
     auto &renderer = *inputTyped->renderer;
 
     auto &world = *inputTyped->world;
-    auto &registry = world.getRegistry();
+    const auto &registry = world.getRegistry();
     auto &sceneGraph = world.getSceneGraph();
 
     auto &renderables = *inputTyped->data;
@@ -41,27 +42,52 @@ Rendering::RenderPassInput *Rendering::BatchPass::execute(RenderPassInput *input
 
     auto isAlphaBlendingEnabled = renderer.isAlphaBlendingEnabled();
 
-    for (auto &e : renderables)
+    // look up the shader key and transparency of every renderable, this only reads components so it is done in parallel
+    std::vector<ShaderMaterial::FragShaderKey> renderableKeys(renderables.size());
+    std::vector<unsigned char> renderableTransparent(renderables.size());
+
+    auto classify = [&](size_t begin, size_t end)
     {
-        ShaderMaterial::FragShaderKey key = DEFAULT_SHADER_KEY;
-        if (registry.has<ShaderMaterial>(e))
+        for (size_t i = begin; i < end; i++)
         {
-            auto &material = registry.get<ShaderMaterial>(e);
-            key = material.getFragmentShaderKey();
+            auto e = renderables[i];
+
+            ShaderMaterial::FragShaderKey key = DEFAULT_SHADER_KEY;
+            if (auto material = registry.tryGet<ShaderMaterial>(e))
+            {
+                key = material->getFragmentShaderKey();
+            }
+
+            auto material = getMaterial(registry, e);
+
+            renderableKeys[i] = key;
+            renderableTransparent[i] = isAlphaBlendingEnabled && material->isTransparent();
         }
+    };
+
+    if (inputTyped->jobSystem != nullptr)
+    {
+        inputTyped->jobSystem->parallelFor(0, renderables.size(), BATCH_PASS_GRAIN_SIZE, classify);
+    }
+    else
+    {
+        classify(0, renderables.size());
+    }
 
-        auto material = getMaterial(registry, e);
+    for (size_t i = 0; i < renderables.size(); i++)
+    {
+        auto e = renderables[i];
 
-        if (isAlphaBlendingEnabled && material->isTransparent())
+        if (renderableTransparent[i])
         {
             transparentRenderables.push_back(e);
-            transparentKeys.push_back(key);
+            transparentKeys.push_back(renderableKeys[i]);
             transparentZIndices.push_back(registry.get<Core::Transform>(e).getZIndex());
         }
         else
         {
             opaqueRenderables.push_back(e);
-            opaqueKeys.push_back(key);
+            opaqueKeys.push_back(renderableKeys[i]);
         }
     }
 
@@ -104,121 +130,94 @@ Rendering::RenderPassInput *Rendering::BatchPass::execute(RenderPassInput *input
         batches->emplace_back(std::move(batch.second));
     }
 
-    // split transparent renderables into layers and their shader materials
-    std::map<unsigned int, std::unordered_map<ShaderMaterial::FragShaderKey, std::vector<ECS::Entity>>> layeredTransparentRenderables;
-
-    for (size_t i = 0; i < transparentRenderables.size(); i++)
+    // order transparent renderables by z index (back to front) for correct alpha blending, and by shader within a layer
+    // so each layer is a run of renderables, split into runs of the same shader
+    // 32 bit indices, there can't be more renderables than entities
+    std::vector<uint32_t> transparentOrder(transparentRenderables.size());
+    for (size_t i = 0; i < transparentOrder.size(); i++)
     {
-        auto &e = transparentRenderables[i];
-        auto &key = transparentKeys[i];
-        auto &zIndex = transparentZIndices[i];
-
-        if (!layeredTransparentRenderables.contains(zIndex))
-        {
-            layeredTransparentRenderables.emplace(zIndex, std::unordered_map<ShaderMaterial::FragShaderKey, std::vector<ECS::Entity>>());
-        }
+        transparentOrder[i] = static_cast<uint32_t>(i);
+    }
 
-        auto &layer = layeredTransparentRenderables[zIndex];
+    std::sort(transparentOrder.begin(), transparentOrder.end(), [&](uint32_t a, uint32_t b)
+              { return transparentZIndices[a] != transparentZIndices[b] ? transparentZIndices[a] < transparentZIndices[b] : transparentKeys[a] < transparentKeys[b]; });
 
-        if (!layer.contains(key))
-        {
-            layer.emplace(key, std::vector<ECS::Entity>());
-        }
+    // create transparent batches
+    // a batch can continue into the next layer while the shader stays the same, as everything in it is drawn before the next layer
+    Batch batch;
+    batch.transparent = true;
 
-        layer[key].push_back(e);
-    }
+    bool batchOpen = false;
 
-    // create transparent batches
-    size_t batchedEntities = 0;
+    size_t layerStart = 0;
 
-    while (batchedEntities < transparentRenderables.size())
+    while (layerStart < transparentOrder.size())
     {
-        Batch batch;
-        batch.transparent = true;
+        auto zIndex = transparentZIndices[transparentOrder[layerStart]];
 
-        bool looped = false;
+        size_t layerEnd = layerStart;
+        while (layerEnd < transparentOrder.size() && transparentZIndices[transparentOrder[layerEnd]] == zIndex)
+        {
+            layerEnd++;
+        }
 
-        auto it = layeredTransparentRenderables.begin();
+        // split the layer into runs of the same shader
+        std::vector<std::pair<size_t, size_t>> runs;
 
-        // while there is only entities with the same shader on this layer
-        // we keep adding them to the batch
-        while (it != layeredTransparentRenderables.end() && it->second.size() == 1)
+        for (size_t runStart = layerStart; runStart < layerEnd;)
         {
+            auto key = transparentKeys[transparentOrder[runStart]];
 
-            auto &layer = it->second;
-            auto &key = layer.begin()->first;
-            auto &entities = layer.begin()->second;
-
-            if (looped && key != batch.key)
+            size_t runEnd = runStart;
+            while (runEnd < layerEnd && transparentKeys[transparentOrder[runEnd]] == key)
             {
-                break;
+                runEnd++;
             }
 
-            batch.key = key;
-            looped = true;
-
-            batch.renderables.reserve(batch.renderables.size() + entities.size());
-            batch.renderables.insert(batch.renderables.end(), entities.begin(), entities.end());
-
-            it = layeredTransparentRenderables.erase(it);
-
-            // std::cout << "added " << entities.size() << " entities to batch" << std::endl;
+            runs.emplace_back(runStart, runEnd);
+            runStart = runEnd;
         }
 
-        // std::cout << "batched " << batch.renderables.size() << " entities" << std::endl;
-
-        // batch has been filled with entities with the same shader
-        // we are now on a layer with entities with different shaders
-        // so we must create new batches for each shader
-
-        // try to add to current batch before creating new batches
-        if (it != layeredTransparentRenderables.end())
+        // the order within a layer doesn't matter, so the run with the open batch's shader goes first to continue the batch
+        if (batchOpen)
         {
-            auto &layer = it->second;
-
-            if (looped && layer.contains(batch.key))
+            for (size_t i = 1; i < runs.size(); i++)
             {
-                auto &entities = layer[batch.key];
-
-                batch.renderables.reserve(batch.renderables.size() + entities.size());
-                batch.renderables.insert(batch.renderables.end(), entities.begin(), entities.end());
-
-                // remove from layer so we don't add them again
-                layer.erase(batch.key);
+                if (transparentKeys[transparentOrder[runs[i].first]] == batch.key)
+                {
+                    std::swap(runs[0], runs[i]);
+                    break;
+                }
             }
-
-            // std::cout << "batched extra from same layer: " << batch.renderables.size() << std::endl;
         }
 
-        // add batch to batches, we can move it because we don't need it anymore
-        if (looped)
+        for (auto &[runStart, runEnd] : runs)
         {
-            batchedEntities += batch.renderables.size();
-            batches->emplace_back(std::move(batch));
-
-            // std::cout << "added batch to batches" << std::endl;
-        }
+            auto key = transparentKeys[transparentOrder[runStart]];
 
-        // no more layers to check
-        if (it == layeredTransparentRenderables.end())
-        {
-            break;
-        }
+            if (!batchOpen || key != batch.key)
+            {
+                if (batchOpen)
+                {
+                    batches->emplace_back(std::move(batch));
+                }
 
-        // create batches for each shader
-        for (auto &key : it->second)
-        {
-            batchedEntities += key.second.size();
-            batches->emplace_back(Batch{true, key.first, std::move(key.second)});
+                batch = Batch{true, key, {}};
+                batchOpen = true;
+            }
 
-            // std::cout << "batched from different layer: " << batches->back().renderables.size() << std::endl;
-            // std::cout << "added batch to batches" << std::endl;
+            for (size_t i = runStart; i < runEnd; i++)
+            {
+                batch.renderables.push_back(transparentRenderables[transparentOrder[i]]);
+            }
         }
 
-        // remove layer as we don't need it anymore
-        layeredTransparentRenderables.erase(it);
+        layerStart = layerEnd;
+    }
 
-        // std::cout << "removed layer" << std::endl;
+    if (batchOpen)
+    {
+        batches->emplace_back(std::move(batch));
     }
 
     // create output
@@ -231,39 +230,9 @@ Rendering::RenderPassInput *Rendering::BatchPass::execute(RenderPassInput *input
 
 void Rendering::BatchPass::sortRenderables(const ECS::Registry &registry, std::vector<ECS::Entity> &renderables)
 {
-    std::map<unsigned int, std::vector<ECS::Entity>> layers;
-
-    for (auto &e : renderables)
-    {
-        auto &transform = registry.get<Core::Transform>(e);
-        auto zIndex = transform.getZIndex();
-
-        if (!layers.contains(zIndex))
-        {
-            layers.emplace(zIndex, std::vector<ECS::Entity>());
-        }
-
-        layers[zIndex].push_back(e);
-    }
-
-    renderables.clear();
-    renderables.reserve(renderables.size());
-
-    for (auto &layer : layers)
-    {
-        for (auto &e : layer.second)
-        {
-            renderables.push_back(e);
-        }
-    }
+    // stable so renderables on the same layer keep their order
+    std::stable_sort(renderables.begin(), renderables.end(), [&registry](ECS::Entity a, ECS::Entity b)
+                     { return registry.get<Core::Transform>(a).getZIndex() < registry.get<Core::Transform>(b).getZIndex(); });
 
     // first renderable should be at lowest index and last renderable at highest index
-
-    // auto first = renderables.front();
-    // auto &firstTransform = registry.get<Core::Transform>(first);
-
-    // auto last = renderables.back();
-    // auto &lastTransform = registry.get<Core::Transform>(last);
-
-    // std::cout << "first: " << firstTransform.getZIndex() << ", last: " << lastTransform.getZIndex() << std::endl;
-}
+}
\ No newline at end of file
@@ -9,6 +9,11 @@
 #include <iostream>
 #include <fstream>
 
+Rendering::CullingPass::~CullingPass()
+{
+    unsubscribe();
+}
+
 Rendering::RenderPassInput *Rendering::CullingPass::execute(RenderPassInput *input)
 {
     checkInput<RenderablesPassData>(input);
@@ -16,7 +21,7 @@ Rendering::RenderPassInput *Rendering::CullingPass::execute(RenderPassInput *inp
     auto inputTyped = static_cast<RenderPassInputTyped<RenderablesPassData> *>(input);
 
     auto &world = *inputTyped->world;
-    auto &registry = world.getRegistry();
+    const auto &registry = world.getRegistry();
 
     auto camera = inputTyped->camera;
     auto &data = *inputTyped->data;
@@ -24,6 +29,28 @@ Rendering::RenderPassInput *Rendering::CullingPass::execute(RenderPassInput *inp
     // get camera aabb
     auto viewAabb = getCullingAABB(world, *inputTyped->spaceTransformer, camera);
 
+    if (signalRegistry != &registry)
+    {
+        unsubscribe();
+        subscribe(registry);
+    }
+
+    // remove entities which are no longer renderable from the trees
+    for (auto &e : data.removedRenderables)
+    {
+        removeFromTrees(e);
+    }
+
+    for (auto &e : destroyedRenderables)
+    {
+        removeFromTrees(e);
+    }
+
+    destroyedRenderables.clear();
+
+    // changes made while culling are picked up next time
+    uint64_t changeTick = registry.advanceChangeTick();
+
     // get renderables
     std::vector<ECS::Entity> *renderables = new std::vector<ECS::Entity>;
     renderables->reserve(data.staticRenderables.size() + data.dynamicRenderables.size());
@@ -34,6 +61,8 @@ Rendering::RenderPassInput *Rendering::CullingPass::execute(RenderPassInput *inp
     // get dynamic renderables
     getRenderables(world, data.dynamicRenderables, viewAabb, false, *renderables);
 
+    lastChangeTick = changeTick;
+
     // create output
     RenderPassInputTyped<CullingPassData> *output = new RenderPassInputTyped<CullingPassData>(input, renderables);
 
@@ -70,7 +99,7 @@ Rendering::RenderPassInput *Rendering::CullingPass::execute(RenderPassInput *inp
 
 Core::AABB Rendering::CullingPass::getCullingAABB(World::World &world, const Core::SpaceTransformer &spaceTransformer, const ECS::Entity camera) const
 {
-    auto &registry = world.getRegistry();
+    const auto &registry = world.getRegistry();
     auto &sceneGraph = world.getSceneGraph();
 
     auto &cameraComponent = registry.get<Camera>(camera);
@@ -94,76 +123,75 @@ Core::AABB Rendering::CullingPass::getCullingAABB(World::World &world, const Cor
     }
 }
 
-void Rendering::CullingPass::pruneTrees(const ECS::Registry &registry)
+void Rendering::CullingPass::subscribe(const ECS::Registry &registry)
 {
-    auto &staticTreeEntities = staticRenderablesTree.getIds();
-    std::vector<ECS::Entity> toRemove;
+    signalRegistry = &registry;
+    auto &signals = registry.getSignals();
 
-    for (auto &e : staticTreeEntities)
-    {
-        if (!registry.has<Renderable>(e))
-        {
-            toRemove.push_back(e);
-        }
-    }
+    renderableDestroyedListenerId = signals.subscribe<ECS::ComponentDestroyed<Renderable>>([this](const ECS::ComponentDestroyed<Renderable> &signal)
+                                                                                           { destroyedRenderables.push_back(signal.entity); });
 
-    for (auto &e : toRemove)
+    // the registry may be destroyed before the pass, in which case there is nothing to unsubscribe from
+    registryDestroyedListenerId = signals.subscribe<ECS::RegistryDestroyed>([this](const ECS::RegistryDestroyed &)
+                                                                            { signalRegistry = nullptr; });
+}
+
+void Rendering::CullingPass::unsubscribe()
+{
+    if (signalRegistry == nullptr)
     {
-        staticRenderablesTree.remove(e);
-        staticRenderables.erase(e);
+        return;
     }
 
-    auto &dynamicTreeEntities = dynamicRenderablesTree.getIds();
-    toRemove.clear();
+    auto &signals = signalRegistry->getSignals();
+
+    signals.unsubscribe<ECS::ComponentDestroyed<Renderable>>(renderableDestroyedListenerId);
+    signals.unsubscribe<ECS::RegistryDestroyed>(registryDestroyedListenerId);
 
-    for (auto &e : dynamicTreeEntities)
+    signalRegistry = nullptr;
+}
+
+void Rendering::CullingPass::removeFromTrees(ECS::Entity entity)
+{
+    if (staticRenderablesTree.has(entity))
     {
-        if (!registry.has<Renderable>(e))
-        {
-            toRemove.push_back(e);
-        }
+        staticRenderablesTree.remove(entity);
+        staticRenderables.erase(entity);
     }
 
-    for (auto &e : toRemove)
+    if (dynamicRenderablesTree.has(entity))
     {
-        dynamicRenderablesTree.remove(e);
-        dynamicRenderables.erase(e);
+        dynamicRenderablesTree.remove(entity);
+        dynamicRenderables.erase(entity);
     }
 }
 
 void Rendering::CullingPass::getRenderables(World::World &world, const std::vector<ECS::Entity> &entities, const Core::AABB &viewAabb, bool isStatic, std::vector<ECS::Entity> &renderables)
 {
-    auto &registry = world.getRegistry();
+    const auto &registry = world.getRegistry();
     auto &sceneGraph = world.getSceneGraph();
 
     auto &tree = isStatic ? staticRenderablesTree : dynamicRenderablesTree;
     auto &map = isStatic ? staticRenderables : dynamicRenderables;
 
-    // prune trees
-    callsSinceLastTreePrune++;
-    if (callsSinceLastTreePrune == treePruneFrequency)
-    {
-        // std::cout << "pruning trees\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n"
-        //           << std::endl;
-
-        pruneTrees(registry);
-        callsSinceLastTreePrune = 0;
-    }
-
     size_t insertionCount = 0;
 
     // auto start = Core::timeSinceEpochMicrosec();
 
     for (auto &e : entities)
     {
-        auto &renderable = registry.get<Renderable>(e);
-
         // skip if already in tree and is static
         if (isStatic && map.contains(e))
         {
             continue;
         }
 
+        // skip recalculating the aabb of dynamic renderables which haven't moved or changed mesh
+        if (!isStatic && tree.has(e) && !sceneGraph.hasWorldTransformChanged(e, lastChangeTick) && !registry.hasChanged<Mesh2D>(e, lastChangeTick))
+        {
+            continue;
+        }
+
         auto &transform = sceneGraph.getModelMatrix(e);
         auto &mesh = registry.get<Mesh2D>(e);
 
@@ -271,7 +299,7 @@ void Rendering::CullingPass::drawAABBTree(bool isStatic, World::World &world, co
     auto entity = registry.create();
     auto &transform = registry.add(entity, Core::Transform());
     auto &material = registry.add(entity, Rendering::Material());
-    auto &mesh = registry.add(entity, Rendering::Mesh2D(1.0f, 1.0f));
+    auto &mesh = registry.emplace<Rendering::Mesh2D>(entity, 1.0f, 1.0f);
 
     for (auto &[aabb, isLeaf, isFat, isLeftChild] : aabbs)
     {
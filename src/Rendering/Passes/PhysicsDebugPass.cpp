@@ -42,7 +42,7 @@ Rendering::RenderPassInput *Rendering::PhysicsDebugPass::execute(Rendering::Rend
             auto body = fixture->GetBody();
 
             auto e = registry.create();
-            auto &mesh = registry.add(e, Rendering::Mesh2D());
+            auto &mesh = registry.emplace<Rendering::Mesh2D>(e);
             auto &transform = registry.add(e, Core::Transform());
             auto &material = registry.add(e, Rendering::Material());
             auto &renderable = registry.add(e, Rendering::Renderable(true, false));
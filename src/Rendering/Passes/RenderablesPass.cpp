@@ -12,39 +12,74 @@ Rendering::RenderPassInput *Rendering::RenderablesPass::execute(RenderPassInput
     auto *inputTyped = static_cast<RenderPassInputTyped<int> *>(input);
 
     auto &world = *input->world;
-    auto &registry = world.getRegistry();
+    const auto &registry = world.getRegistry();
+
+    // resolve the view once per registry
+    if (view.getRegistry() != &registry)
+    {
+        view = registry.persistentView<Mesh2D, Core::Transform, Renderable>();
+        lastViewCacheTime = 0;
+    }
 
     // get entities
-    auto &entities = registry.view<Mesh2D, Core::Transform, Renderable>();
-    auto cacheTime = registry.viewCachedTime<Mesh2D, Core::Transform, Renderable>();
+    auto &entities = view.getEntities();
+    auto cacheTime = view.getCachedTime();
 
     // cached data exists
     if (cacheTime == lastViewCacheTime)
     {
         auto data = new RenderablesPassData();
-        data->staticRenderables = oldData.staticRenderables;
-        data->dynamicRenderables = oldData.dynamicRenderables;
 
-        auto &added = registry.viewAddedSinceTimestamp<Mesh2D, Core::Transform, Renderable>();
+        auto &removed = view.getRemovedSinceTimestamp();
+        auto &added = view.getAddedSinceTimestamp();
 
-        // we need to make sure the newly added renderables are included in future passes
-        // NOTE: not the most optimal solution but couldn't find a better way to do this right now
-        // should maybe look at in future if becomes a performance issue
-        if (!added.empty())
+        // apply removals first, entities that were removed and added back will be in both lists
+        if (removed.empty())
         {
-            for (auto e : added)
-            {
-                auto &renderable = registry.get<Renderable>(e);
+            data->staticRenderables = oldData.staticRenderables;
+            data->dynamicRenderables = oldData.dynamicRenderables;
+        }
+        else
+        {
+            std::unordered_set<ECS::Entity> removedSet(removed.begin(), removed.end());
+
+            data->staticRenderables.reserve(oldData.staticRenderables.size());
+            data->dynamicRenderables.reserve(oldData.dynamicRenderables.size());
 
-                if (renderable.isStatic)
+            for (auto e : oldData.staticRenderables)
+            {
+                if (!removedSet.contains(e))
                 {
-                    data->newStaticRenderables.push_back(e);
+                    data->staticRenderables.push_back(e);
                 }
-                else
+            }
+
+            for (auto e : oldData.dynamicRenderables)
+            {
+                if (!removedSet.contains(e))
                 {
-                    data->newDynamicRenderables.push_back(e);
+                    data->dynamicRenderables.push_back(e);
                 }
             }
+
+            data->removedRenderables = removed;
+        }
+
+        // we need to make sure the newly added renderables are included in future passes
+        for (auto e : added)
+        {
+            auto &renderable = registry.get<Renderable>(e);
+
+            if (renderable.isStatic)
+            {
+                data->staticRenderables.push_back(e);
+                data->newStaticRenderables.push_back(e);
+            }
+            else
+            {
+                data->dynamicRenderables.push_back(e);
+                data->newDynamicRenderables.push_back(e);
+            }
         }
 
         return new RenderPassInputTyped(input, data);
@@ -29,6 +29,7 @@ void Rendering::RenderManager::render(World::World &world, ECS::Entity *camera,
     input->renderTarget = renderTarget;
     input->textureManager = &this->renderer->getTextureManager();
     input->spaceTransformer = this->spaceTransformer;
+    input->jobSystem = world.getJobSystem();
     input->data = new int(0);
 
     pipeline->execute(input);
@@ -165,10 +165,9 @@ void Rendering::Renderer::entity(const World::World &world, const ECS::Entity ca
 
     meshShader.uniform(&uMeshTransform);
 
-    if (registry.has<ShaderMaterial>(entity))
+    if (auto shaderMaterial = registry.tryGet<ShaderMaterial>(entity))
     {
-        auto &shaderMaterial = registry.get<ShaderMaterial>(entity);
-        meshShader.uniform(shaderMaterial.getUniforms());
+        meshShader.uniform(shaderMaterial->getUniforms());
     }
 
     meshShader.attrib(&aPos);
@@ -266,10 +265,9 @@ void Rendering::Renderer::instance(const World::World &world, const ECS::Entity
     instancedMeshShader.uniform(&uTextureAtlasSize);
     instancedMeshShader.uniform(&uTextures);
 
-    if (registry.has<ShaderMaterial>(instances[0]))
+    if (auto shaderMaterial = registry.tryGet<ShaderMaterial>(instances[0]))
     {
-        auto &shaderMaterial = registry.get<ShaderMaterial>(instances[0]);
-        instancedMeshShader.uniform(shaderMaterial.getUniforms());
+        instancedMeshShader.uniform(shaderMaterial->getUniforms());
     }
 
     instancedMeshShader.attrib(attribs);
@@ -408,13 +406,12 @@ void Rendering::Renderer::batch(const World::World &world, const ECS::Entity cam
     batchedMeshShader.uniform(&uTextureAtlasSize);
     batchedMeshShader.uniform(&uTextures);
 
-    if (registry.has<ShaderMaterial>(renderables[0]))
+    if (auto shaderMaterial = registry.tryGet<ShaderMaterial>(renderables[0]))
     {
-        auto &shaderMaterial = registry.get<ShaderMaterial>(renderables[0]);
-        batchedMeshShader.uniform(shaderMaterial.getUniforms());
+        batchedMeshShader.uniform(shaderMaterial->getUniforms());
 
-        // if (shaderMaterial.getUniforms().contains("uTime"))
-        //     std::cout << *static_cast<float *>(shaderMaterial.getUniforms().at("uTime")->getValuePointer()) << std::endl;
+        // if (shaderMaterial->getUniforms().contains("uTime"))
+        //     std::cout << *static_cast<float *>(shaderMaterial->getUniforms().at("uTime")->getValuePointer()) << std::endl;
     }
 
     batchedMeshShader.attrib(&aPos);
@@ -555,20 +552,25 @@ glm::uvec2 Rendering::Renderer::getWindowSize() const
 
 ECS::Entity Rendering::Renderer::getActiveCamera(const ECS::Registry &registry) const
 {
-    auto activeCameras = registry.view<ActiveCamera>();
+    // the active camera is a tag, so counting and finding it only touches the ids of its pool
+    auto count = registry.count<ActiveCamera>();
 
-    if (activeCameras.size() == 0)
+    if (count == 0)
     {
         throw std::runtime_error("Renderer (getActiveCamera): no active camera.");
     }
-    else if (activeCameras.size() > 1)
+    else if (count > 1)
     {
         throw std::runtime_error("Renderer (getActiveCamera): more than one active camera.");
     }
 
-    if (registry.has<Camera>(activeCameras[0]) && registry.has<Core::Transform>(activeCameras[0]))
+    ECS::Entity activeCamera = ECS::NULL_ENTITY;
+    registry.each<ActiveCamera>([&activeCamera](ECS::Entity entity, const ActiveCamera &)
+                                { activeCamera = entity; });
+
+    if (registry.has<Camera, Core::Transform>(activeCamera))
     {
-        return activeCameras[0];
+        return activeCamera;
     }
     else
     {
@@ -643,10 +645,9 @@ Rendering::RendererShaders &Rendering::Renderer::getShaders(const ShaderMaterial
 
 Rendering::RendererShaders &Rendering::Renderer::getShaders(const ECS::Registry &registry, const ECS::Entity entity) const
 {
-    if (registry.has<ShaderMaterial>(entity))
+    if (auto material = registry.tryGet<ShaderMaterial>(entity))
     {
-        auto &material = registry.get<ShaderMaterial>(entity);
-        return getShaders(material);
+        return getShaders(*material);
     }
     else
     {
@@ -3,6 +3,7 @@
 
 Rendering::AnimationSystem::AnimationSystem()
 {
+    declareWrite<AnimatedMaterial>();
 }
 
 Rendering::AnimationSystem::~AnimationSystem()
@@ -16,14 +17,12 @@ void Rendering::AnimationSystem::update(const ECS::System::SystemUpdateData &dat
 
     auto &registry = world.getRegistry();
 
-    auto &entities = registry.view<AnimatedMaterial>();
-
     // step all animated textures
     auto dt = timestep.getSeconds();
 
-    for (auto &entity : entities)
-    {
-        auto &animatedMaterial = registry.get<AnimatedMaterial>(entity);
-        animatedMaterial.step(dt);
-    }
+    // stepping only touches the material itself, so chunks of materials can be stepped in parallel
+    registry.parallelEach<AnimatedMaterial>([dt](ECS::Entity, AnimatedMaterial &animatedMaterial)
+                                            { animatedMaterial.step(dt); });
+
+    addTouchedEntities(registry.count<AnimatedMaterial>());
 }
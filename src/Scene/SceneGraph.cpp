@@ -5,10 +5,13 @@
 
 Scene::SceneGraph::SceneGraph(const ECS::Registry *registry) : registry(registry)
 {
+    transformDestroyedListenerId = registry->getSignals().subscribe<ECS::ComponentDestroyed<Core::Transform>>([this](const ECS::ComponentDestroyed<Core::Transform> &signal)
+                                                                                                              { removedTransforms.push_back(signal.entity); });
 }
 
 Scene::SceneGraph::~SceneGraph()
 {
+    registry->getSignals().unsubscribe<ECS::ComponentDestroyed<Core::Transform>>(transformDestroyedListenerId);
 }
 
 void Scene::SceneGraph::relate(ECS::Entity parent, ECS::Entity child)
@@ -31,6 +34,9 @@ void Scene::SceneGraph::relate(ECS::Entity parent, ECS::Entity child)
     childrenMap[parent].emplace(child);
     parents[child] = parent;
 
+    // the world transform of the child changes with its parent
+    registry->markChanged<Core::Transform>(child);
+
     updateModelMatrix(child, false, true);
 }
 
@@ -42,6 +48,32 @@ void Scene::SceneGraph::relate(ECS::Entity parent, const std::vector<ECS::Entity
     }
 }
 
+void Scene::SceneGraph::relate(std::span<const ECS::Entity> parents, std::span<const ECS::Entity> children)
+{
+    if (parents.size() != children.size())
+    {
+        throw std::invalid_argument("SceneGraph (relate): There must be a parent for every child.");
+    }
+
+    for (size_t i = 0; i < children.size(); i++)
+    {
+        if (!registry->has<Core::Transform>(parents[i]))
+        {
+            throw std::invalid_argument("SceneGraph (relate): Parent entity does not have a transform component.");
+        }
+
+        if (!registry->has<Core::Transform>(children[i]))
+        {
+            throw std::invalid_argument("SceneGraph (relate): Child entity does not have a transform component.");
+        }
+    }
+
+    for (size_t i = 0; i < children.size(); i++)
+    {
+        relate(parents[i], children[i]);
+    }
+}
+
 void Scene::SceneGraph::unrelate(ECS::Entity entity)
 {
     if (!hasParent(entity))
@@ -57,6 +89,7 @@ void Scene::SceneGraph::unrelate(ECS::Entity entity)
     // update if entity has transform component
     if (registry->has<Core::Transform>(entity))
     {
+        registry->markChanged<Core::Transform>(entity);
         updateModelMatrix(entity, false, true);
     }
 }
@@ -155,44 +188,155 @@ void Scene::SceneGraph::updateModelMatrix(ECS::Entity entity, bool updateParent,
 
 void Scene::SceneGraph::updateModelMatrices()
 {
-    auto entities = registry->view<Core::Transform>();
+    uint64_t tick = registry->advanceChangeTick();
+    auto changed = registry->changed<Core::Transform>(lastChangeTick);
+    lastChangeTick = tick;
 
-    std::vector<ECS::Entity> rootEntities;
-    rootEntities.reserve(entities.size());
+    // remove entities no longer in registry
+    removeEntitiesNotInRegistry();
+
+    std::unordered_set<ECS::Entity> changedSet(changed.begin(), changed.end());
 
-    for (auto &[parent, children] : childrenMap)
+    // recurse down the subtrees of changed entities updating model matrices
+    for (auto &e : changed)
     {
-        if (!hasParent(parent))
+        if (!hasParent(e) && !hasChildren(e))
         {
-            rootEntities.push_back(parent);
+            continue;
+        }
+
+        // the subtree of a changed ancestor already includes this entity
+        bool ancestorChanged = false;
+
+        for (auto ancestor = e; hasParent(ancestor);)
+        {
+            ancestor = parent(ancestor);
+
+            if (changedSet.contains(ancestor))
+            {
+                ancestorChanged = true;
+                break;
+            }
+        }
+
+        if (!ancestorChanged)
+        {
+            updateModelMatrix(e, false, true);
         }
     }
+}
 
-    // remove entities no longer in registry
-    removeEntitiesNotInRegistry();
+void Scene::SceneGraph::removeEntitiesNotInRegistry()
+{
+    for (auto e : removedTransforms)
+    {
+        // the transform may have been added back since it was removed
+        if (registry->has<Core::Transform>(e) || !modelMatrices.contains(e))
+        {
+            continue;
+        }
 
-    // recurse down tree updating model matrices
-    for (auto &rootEntity : rootEntities)
+        unrelate(e);
+        modelMatrices.erase(e);
+    }
+
+    removedTransforms.clear();
+}
+
+
+bool Scene::SceneGraph::hasWorldTransformChanged(ECS::Entity entity, uint64_t sinceTick) const
+{
+    if (registry->hasChanged<Core::Transform>(entity, sinceTick))
     {
-        updateModelMatrix(rootEntity, false, true);
+        return true;
     }
+
+    for (auto ancestor = entity; hasParent(ancestor);)
+    {
+        ancestor = parent(ancestor);
+
+        if (registry->hasChanged<Core::Transform>(ancestor, sinceTick))
+        {
+            return true;
+        }
+    }
+
+    return false;
 }
 
-void Scene::SceneGraph::removeEntitiesNotInRegistry()
+void Scene::SceneGraph::clear()
 {
-    for (auto it = modelMatrices.begin(); it != modelMatrices.end();)
+    parents.clear();
+    childrenMap.clear();
+    modelMatrices.clear();
+    removedTransforms.clear();
+}
+
+void Scene::SceneGraph::writeSnapshot(ECS::SnapshotWriter &writer) const
+{
+    writer.write<uint64_t>(parents.size());
+
+    for (auto &[child, parent] : parents)
+    {
+        writer.write<ECS::Entity>(child);
+        writer.write<ECS::Entity>(parent);
+    }
+}
+
+void Scene::SceneGraph::readSnapshot(ECS::SnapshotReader &reader)
+{
+    clear();
+
+    try
     {
-        auto &e = it->first;
-        auto &modelMatrix = it->second;
+        auto count = reader.read<uint64_t>();
 
-        if (!registry->has<Core::Transform>(e))
+        for (uint64_t i = 0; i < count; i++)
         {
-            unrelate(e);
-            it = modelMatrices.erase(it);
+            auto child = reader.read<ECS::Entity>();
+            auto parent = reader.read<ECS::Entity>();
+
+            if (!registry->has<Core::Transform>(parent) || !registry->has<Core::Transform>(child))
+            {
+                throw std::invalid_argument("SceneGraph (readSnapshot): Related entity does not have a transform component.");
+            }
+
+            if (child == parent)
+            {
+                throw std::runtime_error("SceneGraph (readSnapshot): Entity '" + std::to_string(child) + "' is its own parent.");
+            }
+
+            if (hasParent(child))
+            {
+                throw std::runtime_error("SceneGraph (readSnapshot): Entity '" + std::to_string(child) + "' has more than one parent.");
+            }
+
+            parents[child] = parent;
+            childrenMap[parent].emplace(child);
         }
-        else
+
+        // every ancestor walk must reach a root, a cycle would recurse forever when computing model matrices
+        std::unordered_set<ECS::Entity> reachesRoot;
+        std::unordered_set<ECS::Entity> walked;
+
+        for (auto &[child, parent] : parents)
         {
-            it++;
+            walked.clear();
+
+            for (auto e = child; hasParent(e) && !reachesRoot.contains(e); e = parents.at(e))
+            {
+                if (!walked.emplace(e).second)
+                {
+                    throw std::runtime_error("SceneGraph (readSnapshot): Entity '" + std::to_string(e) + "' is its own ancestor.");
+                }
+            }
+
+            reachesRoot.insert(walked.begin(), walked.end());
         }
     }
-}
+    catch (...)
+    {
+        clear();
+        throw;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "../../include/Utility/MappedFile.h"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+remi::MappedFile::MappedFile(const std::string &path)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("MappedFile (MappedFile): Failed to open file '" + path + "'.");
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        throw std::runtime_error("MappedFile (MappedFile): Failed to get the size of file '" + path + "'.");
+    }
+
+    fileHandle = file;
+    size = static_cast<size_t>(fileSize.QuadPart);
+
+    // an empty file cannot be mapped
+    if (size == 0)
+    {
+        return;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        throw std::runtime_error("MappedFile (MappedFile): Failed to map file '" + path + "'.");
+    }
+
+    mappingHandle = mapping;
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        throw std::runtime_error("MappedFile (MappedFile): Failed to map file '" + path + "'.");
+    }
+
+    data = static_cast<const std::byte *>(view);
+#else
+    int file = open(path.c_str(), O_RDONLY);
+    if (file == -1)
+    {
+        throw std::runtime_error("MappedFile (MappedFile): Failed to open file '" + path + "'.");
+    }
+
+    struct stat fileStat;
+    if (fstat(file, &fileStat) == -1)
+    {
+        close(file);
+        throw std::runtime_error("MappedFile (MappedFile): Failed to get the size of file '" + path + "'.");
+    }
+
+    size = static_cast<size_t>(fileStat.st_size);
+
+    // an empty file cannot be mapped
+    if (size == 0)
+    {
+        close(file);
+        return;
+    }
+
+    void *view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+
+    // the mapping keeps its own reference to the file
+    close(file);
+
+    if (view == MAP_FAILED)
+    {
+        throw std::runtime_error("MappedFile (MappedFile): Failed to map file '" + path + "'.");
+    }
+
+    data = static_cast<const std::byte *>(view);
+#endif
+}
+
+remi::MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+    if (data != nullptr)
+    {
+        UnmapViewOfFile(data);
+    }
+
+    if (mappingHandle != nullptr)
+    {
+        CloseHandle(mappingHandle);
+    }
+
+    if (fileHandle != nullptr)
+    {
+        CloseHandle(fileHandle);
+    }
+#else
+    if (data != nullptr)
+    {
+        munmap(const_cast<std::byte *>(data), size);
+    }
+#endif
+}
+
+const std::byte *remi::MappedFile::getData() const
+{
+    return data;
+}
+
+size_t remi::MappedFile::getSize() const
+{
+    return size;
+}
\ No newline at end of file
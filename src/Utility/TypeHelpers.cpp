@@ -3,7 +3,7 @@
 #include <iostream>
 #include <string>
 #include <unordered_map>
-
+#include <mutex>
 
 remi::TypeId remi::generateTypeId(const char *typeName)
 {
@@ -11,6 +11,9 @@ remi::TypeId remi::generateTypeId(const char *typeName)
     // wasm might not like variables declared outside of functions and being used but who knows
     // works as static variable
     static std::unordered_map<std::string, remi::TypeId> memoizedTypeIds;
+    static std::mutex memoizedTypeIdsMutex;
+
+    std::lock_guard<std::mutex> lock(memoizedTypeIdsMutex);
 
     std::string name(typeName);
 
@@ -40,4 +43,15 @@ remi::TypeId remi::generateTypeId(const char *typeName)
     // std::cout << "memoizedTypeIds[name]: " << memoizedTypeIds[name] << std::endl;
 
     return h; // or return h % C;
+}
+
+size_t remi::generateTypeIndex(const char *typeName)
+{
+    static std::unordered_map<std::string, size_t> typeIndices;
+    static std::mutex typeIndicesMutex;
+
+    std::lock_guard<std::mutex> lock(typeIndicesMutex);
+
+    // emplace only inserts if the type has not been seen, so the next index is the number of types seen so far
+    return typeIndices.emplace(typeName, typeIndices.size()).first->second;
 }
\ No newline at end of file
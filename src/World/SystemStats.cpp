@@ -0,0 +1,61 @@
+#include "../../include/World/SystemStats.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+World::SystemTimingRecorder::SystemTimingRecorder(size_t frames) : frames(frames)
+{
+    if (frames == 0)
+    {
+        throw std::invalid_argument("SystemTimingRecorder (constructor): frames must be greater than 0.");
+    }
+
+    samples.reserve(frames);
+}
+
+void World::SystemTimingRecorder::record(double time, size_t entities)
+{
+    calls++;
+
+    if (samples.size() < frames)
+    {
+        samples.push_back(Sample{time, entities});
+        return;
+    }
+
+    samples[next] = Sample{time, entities};
+    next = (next + 1) % frames;
+}
+
+World::SystemTimings World::SystemTimingRecorder::getTimings() const
+{
+    SystemTimings timings;
+    timings.calls = calls;
+
+    if (samples.empty())
+    {
+        return timings;
+    }
+
+    // the newest sample is the one before the oldest
+    auto &last = samples[(next + samples.size() - 1) % samples.size()];
+    timings.lastTime = last.time;
+    timings.lastEntities = last.entities;
+
+    double totalTime = 0;
+    double totalEntities = 0;
+
+    for (auto &sample : samples)
+    {
+        totalTime += sample.time;
+        totalEntities += sample.entities;
+
+        timings.maxTime = std::max(timings.maxTime, sample.time);
+        timings.maxEntities = std::max(timings.maxEntities, sample.entities);
+    }
+
+    timings.averageTime = totalTime / samples.size();
+    timings.averageEntities = totalEntities / samples.size();
+
+    return timings;
+}
\ No newline at end of file
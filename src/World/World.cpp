@@ -1,8 +1,32 @@
 #include "../../include/World/World.h"
 
 #include <stdexcept>
+#include <exception>
+#include <chrono>
 
-World::World::World(size_t maxEntities) : registry(ECS::Registry(maxEntities)), sceneGraph(Scene::SceneGraph(&registry))
+namespace
+{
+    /**
+     * Checks that every prefab in a hierarchy which is related to another has a transform, as the scene graph requires.
+     *
+     * @param prefab The prefab.
+     * @param isChild Whether or not the prefab is a child prefab.
+     */
+    void checkPrefabHierarchy(const ECS::Prefab &prefab, bool isChild)
+    {
+        if ((isChild || !prefab.getChildren().empty()) && !prefab.has<Core::Transform>())
+        {
+            throw std::invalid_argument("World (instantiate): Prefabs with children, and child prefabs, must have a transform component.");
+        }
+
+        for (auto &child : prefab.getChildren())
+        {
+            checkPrefabHierarchy(child, true);
+        }
+    }
+}
+
+World::World::World(size_t maxEntities) : registry(ECS::Registry(maxEntities)), sceneGraph(Scene::SceneGraph(&registry)), commandBuffer(&registry)
 {
 }
 
@@ -12,38 +36,14 @@ World::World::~World()
 
 void World::World::update(const ECS::System::SystemUpdateData &data)
 {
-    // create a copy of the systems vector to avoid issues with systems being added or removed during the loop
-    auto systemsCopy = systems;
-
-    for (auto system : systemsCopy)
-    {
-        // system may have been removed during the loop
-        if (!hasSystem(system))
-        {
-            continue;
-        }
-
-        system->update(data);
-    }
+    runSystems(&ECS::System::update, data);
 
     sceneGraph.updateModelMatrices();
 }
 
 void World::World::fixedUpdate(const ECS::System::SystemUpdateData &data)
 {
-    // create a copy of the systems vector to avoid issues with systems being added or removed during the loop
-    auto systemsCopy = systems;
-
-    for (auto system : systemsCopy)
-    {
-        // system may have been removed during the loop
-        if (!hasSystem(system))
-        {
-            continue;
-        }
-
-        system->fixedUpdate(data);
-    }
+    runSystems(&ECS::System::fixedUpdate, data);
 
     sceneGraph.updateModelMatrices();
 }
@@ -67,6 +67,8 @@ bool World::World::addSystem(ECS::System *system)
 
     systemsSet.emplace(system);
     systems.push_back(system);
+    systemRecorders.emplace(system, SystemRecorders{SystemTimingRecorder(systemStatsFrames), SystemTimingRecorder(systemStatsFrames)});
+    stagesDirty = true;
     return true;
 }
 
@@ -83,6 +85,8 @@ bool World::World::removeSystem(ECS::System *system)
         {
             systems.erase(it);
             systemsSet.erase(system);
+            systemRecorders.erase(system);
+            stagesDirty = true;
             return true;
         }
     }
@@ -95,6 +99,84 @@ bool World::World::hasSystem(ECS::System *system)
     return systemsSet.contains(system);
 }
 
+void World::World::fixedUpdateUnscheduled(ECS::System *system, const ECS::System::SystemUpdateData &data)
+{
+    if (system == nullptr)
+    {
+        throw std::invalid_argument("World (fixedUpdateUnscheduled): system cannot be nullptr.");
+    }
+
+    if (hasSystem(system))
+    {
+        throw std::invalid_argument("World (fixedUpdateUnscheduled): system has been added to the world, it would be run twice.");
+    }
+
+    if (!systemRecorders.contains(system))
+    {
+        unscheduledSystems.push_back(system);
+        systemRecorders.emplace(system, SystemRecorders{SystemTimingRecorder(systemStatsFrames), SystemTimingRecorder(systemStatsFrames)});
+    }
+
+    runSystem(system, &ECS::System::fixedUpdate, data);
+}
+
+std::vector<World::SystemStats> World::World::getSystemStats() const
+{
+    std::vector<SystemStats> stats;
+    stats.reserve(systems.size() + unscheduledSystems.size());
+
+    for (auto systemList : {&systems, &unscheduledSystems})
+    {
+        for (auto system : *systemList)
+        {
+            auto &recorders = systemRecorders.at(system);
+
+            stats.push_back(SystemStats{
+                .system = system,
+                .update = recorders.update.getTimings(),
+                .fixedUpdate = recorders.fixedUpdate.getTimings(),
+            });
+        }
+    }
+
+    return stats;
+}
+
+void World::World::setSystemStatsFrames(size_t frames)
+{
+    if (frames == 0)
+    {
+        throw std::invalid_argument("World (setSystemStatsFrames): frames must be greater than 0.");
+    }
+
+    systemStatsFrames = frames;
+    resetSystemStats();
+}
+
+size_t World::World::getSystemStatsFrames() const
+{
+    return systemStatsFrames;
+}
+
+void World::World::resetSystemStats()
+{
+    for (auto &[system, recorders] : systemRecorders)
+    {
+        recorders = SystemRecorders{SystemTimingRecorder(systemStatsFrames), SystemTimingRecorder(systemStatsFrames)};
+    }
+}
+
+void World::World::setJobSystem(Core::JobSystem *jobSystem)
+{
+    this->jobSystem = jobSystem;
+    registry.setJobSystem(jobSystem);
+}
+
+Core::JobSystem *World::World::getJobSystem()
+{
+    return jobSystem;
+}
+
 ECS::Registry &World::World::getRegistry()
 {
     return registry;
@@ -114,3 +196,162 @@ const Scene::SceneGraph &World::World::getSceneGraph() const
 {
     return sceneGraph;
 }
+
+ECS::CommandBuffer &World::World::getCommandBuffer()
+{
+    return commandBuffer;
+}
+
+std::vector<ECS::Entity> World::World::instantiate(const ECS::Prefab &prefab, size_t count, const std::function<void(ECS::Entity, size_t)> &init)
+{
+    checkPrefabHierarchy(prefab, false);
+
+    auto entities = registry.instantiate(prefab, count);
+    instantiateChildren(prefab, entities);
+
+    if (init != nullptr)
+    {
+        for (size_t i = 0; i < entities.size(); i++)
+        {
+            init(entities[i], i);
+        }
+    }
+
+    return entities;
+}
+
+void World::World::instantiateChildren(const ECS::Prefab &prefab, const std::vector<ECS::Entity> &parents)
+{
+    for (auto &child : prefab.getChildren())
+    {
+        auto children = registry.instantiate(child, parents.size());
+        sceneGraph.relate(parents, children);
+
+        instantiateChildren(child, children);
+    }
+}
+
+void World::World::buildStages()
+{
+    stages.clear();
+
+    std::vector<size_t> systemStages(systems.size(), 0);
+
+    for (size_t i = 0; i < systems.size(); i++)
+    {
+        size_t stage = 0;
+
+        for (size_t j = 0; j < i; j++)
+        {
+            if (systemStages[j] >= stage && systems[i]->conflictsWith(*systems[j]))
+            {
+                stage = systemStages[j] + 1;
+            }
+        }
+
+        systemStages[i] = stage;
+
+        if (stage >= stages.size())
+        {
+            stages.resize(stage + 1);
+        }
+
+        stages[stage].push_back(systems[i]);
+    }
+
+    stagesDirty = false;
+}
+
+void World::World::runSystems(void (ECS::System::*update)(const ECS::System::SystemUpdateData &), const ECS::System::SystemUpdateData &data)
+{
+    if (stagesDirty)
+    {
+        buildStages();
+    }
+
+    // systems added during the loop will only be run next time, as they mark the stages as dirty
+    // but the stages being iterated are not changed until then
+    auto stagesCopy = stages;
+
+    std::vector<ECS::System *> stageSystems;
+
+    for (auto &stage : stagesCopy)
+    {
+        stageSystems.clear();
+
+        for (auto system : stage)
+        {
+            // system may have been removed during the loop
+            if (hasSystem(system))
+            {
+                stageSystems.push_back(system);
+            }
+        }
+
+        if (stageSystems.empty())
+        {
+            continue;
+        }
+
+        if (jobSystem == nullptr || stageSystems.size() == 1)
+        {
+            for (auto system : stageSystems)
+            {
+                runSystem(system, update, data);
+            }
+
+            continue;
+        }
+
+        // run the first system on this thread and the rest on the job system
+        Core::JobSystem::Counter counter;
+
+        for (size_t i = 1; i < stageSystems.size(); i++)
+        {
+            auto system = stageSystems[i];
+
+            jobSystem->submit([this, system, update, &data]()
+                              { runSystem(system, update, data); },
+                              counter);
+        }
+
+        std::exception_ptr exception = nullptr;
+
+        try
+        {
+            runSystem(stageSystems[0], update, data);
+        }
+        catch (...)
+        {
+            exception = std::current_exception();
+        }
+
+        // always wait for the other systems before rethrowing, as they reference the update data
+        jobSystem->wait(counter);
+
+        if (exception != nullptr)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+}
+
+void World::World::runSystem(ECS::System *system, void (ECS::System::*update)(const ECS::System::SystemUpdateData &), const ECS::System::SystemUpdateData &data)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    (system->*update)(data);
+
+    double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    size_t touched = system->takeTouchedEntities();
+
+    // an exclusive system may have removed itself
+    auto it = systemRecorders.find(system);
+    if (it == systemRecorders.end())
+    {
+        return;
+    }
+
+    auto &recorder = update == &ECS::System::fixedUpdate ? it->second.fixedUpdate : it->second.update;
+    recorder.record(time, touched);
+}
\ No newline at end of file